@@ -0,0 +1,43 @@
+import numpy as np
+import loudness as ln
+
+'''
+Smoothing variants added with addSmoothingTimes() are computed in one pass
+and should match separate models using the same time-constants.
+'''
+
+fs = 32000
+hopSize = 32
+nHops = 500
+x = 0.05 * np.random.randn(1, 1, nHops * hopSize)
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+
+model = ln.DynamicLoudnessGM2002()
+model.addSmoothingTimes('GM2002')
+model.addSmoothingTimes('MGS2003')
+model.addSmoothingTimes('Custom', 0.02, 0.1, 0.2, 1.0)
+model.initialize(hop)
+names = ['GM2002', 'MGS2003', 'Custom']
+outputs = []
+for name in names:
+    outputs += ['ShortTermLoudness' + name, 'LongTermLoudness' + name]
+results = model.processSignalArray(x, outputs)
+
+for name in names:
+    reference = ln.DynamicLoudnessGM2002()
+    if name == 'Custom':
+        reference.setAttackTimeSTL(0.02)
+        reference.setReleaseTimeSTL(0.1)
+        reference.setAttackTimeLTL(0.2)
+        reference.setReleaseTimeLTL(1.0)
+    else:
+        reference.configureSmoothingTimes(name)
+    reference.initialize(hop)
+    references = ['ShortTermLoudness', 'LongTermLoudness']
+    expected = reference.processSignalArray(x, references)
+    for output in references:
+        print("%s identical: %r"
+              % (output + name,
+                 np.array_equal(expected[output], results[output + name])))
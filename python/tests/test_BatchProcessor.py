@@ -0,0 +1,42 @@
+import numpy as np
+import loudness as ln
+
+'''
+Files with different sampling frequencies and an in-memory signal are
+processed in parallel. Results should match processing each file with
+AudioFileProcessor.
+'''
+
+path = '../../wavs/pureTones/'
+wavs = [path + 'pureTone_1000Hz_40dBSPL_32000Hz.wav',
+        path + 'pureTone_1000Hz_40dBSPL_44100Hz.wav',
+        path + 'pureTone_3000Hz_40dBSPL_48000Hz.wav']
+outputs = ['ShortTermLoudness', 'LongTermLoudness']
+
+prototype = ln.DynamicLoudnessGM2002()
+prototype.setOutputsToAggregate(outputs)
+
+batch = ln.BatchProcessor()
+batch.setNThreads(4)
+for wav in wavs:
+    batch.addFile(wav)
+signal = ln.tools.sound.Sound.tone([1000], dur=0.5, fs=32000)
+signal.useDBSPL()
+signal.normalise(40, "RMS")
+batch.addBuffer(signal.data.flatten(), 1, 32000)
+print("Items processed: %d of %d" % (batch.process(prototype),
+                                     batch.getNItems()))
+
+for i, wav in enumerate(wavs):
+    model = ln.DynamicLoudnessGM2002()
+    model.setOutputsToAggregate(outputs)
+    processor = ln.AudioFileProcessor(wav)
+    processor.initialize(model)
+    processor.processAllFrames(model)
+    for name in outputs:
+        print("%s, %s identical: %r" % (
+            wav, name, np.array_equal(
+                model.getOutput(name).getAggregatedSignals().flatten(),
+                np.array(batch.getAggregatedOutput(i, name)))))
+
+print("Buffer frames: %d" % batch.getNFrames(3))
@@ -0,0 +1,54 @@
+import numpy as np
+import loudness as ln
+
+# Short-term loudness like input (sones), one value per frame
+nFrames = 5000
+x = 10 ** (np.random.uniform(-2, 1.5, nFrames))
+x[::10] = 0.0  # silent frames are ignored
+
+bank = ln.SignalBank()
+bank.initialize(1, 1, 1, 1, 1000)
+
+descriptors = ln.LoudnessDescriptors()
+descriptors.initialize(bank)
+out = descriptors.getOutput()
+
+for value in x:
+    bank.setSample(0, 0, 0, 0, value)
+    descriptors.process(bank)
+
+y = x[x > 0]
+expected = {
+    ln.LoudnessDescriptors.MEAN: np.mean(y),
+    ln.LoudnessDescriptors.MAX: np.max(y),
+    ln.LoudnessDescriptors.MIN: np.min(y),
+    ln.LoudnessDescriptors.N5: np.percentile(y, 95),
+    ln.LoudnessDescriptors.N10: np.percentile(y, 90),
+    ln.LoudnessDescriptors.LOUDNESS_RANGE:
+        10 * np.log10(np.percentile(y, 95) / np.percentile(y, 10)),
+}
+
+for idx, value in expected.items():
+    # percentile estimates are within a histogram bin width (0.1 dB)
+    estimate = out.getSample(0, 0, 0, idx)
+    print("Descriptor %d: expected %0.4f, estimated %0.4f, match: %r"
+          % (idx, value, estimate, np.isclose(estimate, value, rtol=0.03)))
+
+# Attached to a model output
+model = ln.DynamicLoudnessGM2002()
+model.setOutputsToDescribe(['ShortTermLoudness'])
+model.setOutputsToAggregate(['ShortTermLoudness'])
+processor = ln.AudioFileProcessor(
+    '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+)
+processor.initialize(model)
+processor.processAllFrames(model)
+
+stl = model.getOutput('ShortTermLoudness').getAggregatedSignals().flatten()
+stl = stl[stl > 0]
+desc = model.getOutput('ShortTermLoudnessDescriptors')
+print("Model mean STL: expected %0.4f, estimated %0.4f"
+      % (np.mean(stl), desc.getSample(0, 0, 0, ln.LoudnessDescriptors.MEAN)))
+print("Model N5 STL: expected %0.4f, estimated %0.4f"
+      % (np.percentile(stl, 95),
+         desc.getSample(0, 0, 0, ln.LoudnessDescriptors.N5)))
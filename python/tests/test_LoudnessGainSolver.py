@@ -0,0 +1,48 @@
+import numpy as np
+import loudness as ln
+
+'''
+LoudnessGainSolver caches the weighted spectrum once and replays it to find
+the gain giving a target short-term loudness. The solved gain applied to the
+signal should give the target when the whole model is run.
+'''
+
+fs = 32000
+hopSize = 32
+nHops = 1000
+x = 0.05 * np.sin(2 * np.pi * 1000 * np.arange(nHops * hopSize) / float(fs))
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+signal = ln.SignalBank()
+signal.initialize(1, 1, 1, nHops * hopSize, fs)
+
+
+def model():
+    m = ln.DynamicLoudnessGM2002()
+    m.setOutputsToDescribe(['ShortTermLoudness'])
+    m.initialize(hop)
+    return m
+
+
+def meanLoudness(gainInDecibels):
+    m = model()
+    signal.setSignal(0, 0, 0, x * 10 ** (gainInDecibels / 20.0))
+    m.processBlock(signal, nHops)
+    return m.getOutput('ShortTermLoudnessDescriptors').getSample(
+        0, 0, 0, ln.LoudnessDescriptors.MEAN)
+
+reference = meanLoudness(0)
+solverModel = model()
+solver = ln.LoudnessGainSolver()
+signal.setSignal(0, 0, 0, x)
+print("Cached: %r" % solver.cache(solverModel, signal, nHops))
+print("Replay at 0 dB identical: %r"
+      % (solver.computeLoudness(solverModel, 0) == reference))
+
+target = 2 * reference
+gain = solver.solve(solverModel, target)
+print("Gain: %.3f dB after %d evaluations, converged: %r"
+      % (gain, solver.getNIterations(), solver.isConverged()))
+print("Relative error of full run: %.2e"
+      % abs(meanLoudness(gain) / target - 1))
@@ -0,0 +1,44 @@
+import numpy as np
+import loudness as ln
+
+'''
+LoudnessIntegrator should give the same instantaneous, short-term and
+long-term loudness as InstantaneousLoudness followed by two ARAverager
+modules.
+'''
+
+fs = 32000
+nFrames = 200
+nChannels = 40
+specificLoudness = np.random.rand(nFrames, nChannels)
+specificLoudness *= (1 + np.sin(np.linspace(0, 8 * np.pi, nFrames)))[:, None]
+
+bank = ln.SignalBank()
+bank.initialize(1, 1, nChannels, 1, fs)
+bank.setFrameRate(1000)
+bank.setChannelSpacingInCams(0.25)
+
+# Separate modules
+il = ln.InstantaneousLoudness(1.0, True)
+stl = ln.ARAverager(0.0222, 0.0495)
+ltl = ln.ARAverager(0.0995, 0.1995)
+il.addTargetModule(stl)
+stl.addTargetModule(ltl)
+il.initialize(bank)
+
+# Fused stage
+integrator = ln.LoudnessIntegrator(1.0, True, 0.0222, 0.0495, 0.0995, 0.1995)
+integrator.initialize(bank)
+
+expected = np.zeros((nFrames, 3))
+result = np.zeros((nFrames, 3))
+for i in range(nFrames):
+    bank.setSignals(specificLoudness[i].reshape((1, 1, nChannels, 1)))
+    il.process(bank)
+    integrator.process(bank)
+    expected[i] = [il.getOutput().getSample(0, 0, 0, 0),
+                   stl.getOutput().getSample(0, 0, 0, 0),
+                   ltl.getOutput().getSample(0, 0, 0, 0)]
+    result[i] = integrator.getOutput().getSignals()[0, 0, :, 0]
+
+print("Identical: %r" % np.array_equal(expected, result))
@@ -0,0 +1,59 @@
+import numpy as np
+import loudness as ln
+
+'''
+A ModelEnsemble shares the front end (filter, frame generator, window and
+power spectrum) of models with the same configuration, here two parameter
+sets of DynamicLoudnessGM2002. Each output should be identical to that of
+the model on its own.
+'''
+
+fs = 32000
+hopSize = 32
+t = np.arange(int(fs * 1.0)) / float(fs)
+x = 0.05 * np.sin(2 * np.pi * 1000 * t)
+x = np.vstack((x, 0.5 * x)).reshape((1, 2, t.size))
+
+hop = ln.SignalBank()
+hop.initialize(1, 2, 1, hopSize, fs)
+outputs = ['SpecificLoudness', 'ShortTermLoudness', 'LongTermLoudness']
+
+faster = ln.DynamicLoudnessGM2002()
+recent = ln.DynamicLoudnessGM2002()
+recent.configureModelParameters('Recent')
+
+ensemble = ln.ModelEnsemble()
+ensemble.addModel(faster, 'Faster')
+ensemble.addModel(recent, 'Recent')
+ensemble.initialize(hop)
+print("Shared modules: %d" % ensemble.getNSharedModules())
+result = ensemble.processSignalArray(
+    x, ['Faster.' + name for name in outputs] +
+    ['Recent.' + name for name in outputs])
+
+for name, model in [('Faster', faster), ('Recent', recent)]:
+    model.initialize(hop)
+    expected = model.processSignalArray(x, outputs)
+    for output in outputs:
+        print("%s.%s identical: %r" % (name, output,
+              np.array_equal(expected[output],
+                             result[name + '.' + output])))
+
+'''
+Frame skipping set on the ensemble gates each distinct weighted spectrum, so
+the outputs match those of the models skipping frames on their own.
+'''
+ensemble.setFrameSkippingUsed(True)
+ensemble.initialize(hop)
+result = ensemble.processSignalArray(
+    x, ['Faster.ShortTermLoudness', 'Recent.ShortTermLoudness'])
+print("Skipped steady frames: %d of %d"
+      % (ensemble.getNSkippedSteadyFrames(), ensemble.getNGatedFrames()))
+
+for name, model in [('Faster', faster), ('Recent', recent)]:
+    model.setFrameSkippingUsed(True)
+    model.initialize(hop)
+    expected = model.processSignalArray(x, ['ShortTermLoudness'])
+    print("%s.ShortTermLoudness with frame skipping identical: %r"
+          % (name, np.array_equal(expected['ShortTermLoudness'],
+                                  result[name + '.ShortTermLoudness'])))
@@ -0,0 +1,53 @@
+import numpy as np
+import loudness as ln
+
+'''
+SignalBank getters return copies. The view getters return read-only numpy
+views which alias the bank's storage and keep the owning bank or model
+alive.
+'''
+
+fs = 32000
+bank = ln.SignalBank()
+bank.initialize(2, 2, 3, 4, fs)
+x = np.arange(2 * 2 * 3 * 4, dtype=float).reshape((2, 2, 3, 4))
+bank.setSignals(x)
+
+signals = bank.getSignals()
+view = bank.getSignalsView()
+print("Shape: %r" % (view.shape,))
+print("Values match: %r" % np.array_equal(view, x))
+print("Read only: %r" % (not view.flags.writeable))
+
+# Only the view aliases the bank
+bank.setSample(0, 0, 0, 0, -1.0)
+print("View aliases the bank: %r" % (view[0, 0, 0, 0] == -1.0))
+print("Copy unchanged: %r" % (signals[0, 0, 0, 0] == 0.0))
+
+# Copies survive a reset or reinitialisation, a view of a model output
+# outlives the model object
+hopBank = ln.SignalBank()
+hopBank.initialize(1, 1, 1, 32, fs)
+hopBank.setSignal(0, 0, 0, 0.1 * np.random.randn(32))
+model = ln.DynamicLoudnessGM2002()
+model.setOutputsToAggregate(['ShortTermLoudness'])
+model.initialize(hopBank)
+for i in range(10):
+    model.process(hopBank)
+stl = model.getOutput('ShortTermLoudness')
+loudness = stl.getAggregatedSignals()
+expected = loudness.copy()
+model.reset()
+print("Aggregated signals kept after reset: %r"
+      % np.array_equal(loudness, expected))
+signals = stl.getSignals()
+expected = signals.copy()
+model.initialize(hopBank)
+print("Copy kept after reinitialisation: %r"
+      % np.array_equal(signals, expected))
+stl = model.getOutput('ShortTermLoudness')
+signals = stl.getSignalsView()
+expected = signals.copy()
+del model, stl
+print("View valid after model deleted: %r"
+      % np.array_equal(signals, expected))
@@ -0,0 +1,58 @@
+import os
+import tempfile
+import numpy as np
+import loudness as ln
+
+'''
+A model replaying a recorded stage should give the same output as processing
+the audio, and a recording must not be replayed for a different input or
+front end.
+'''
+
+fs = 32000
+hopSize = 32
+nHops = 500
+x = 0.05 * np.random.randn(nHops * hopSize)
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+signal = ln.SignalBank()
+signal.initialize(1, 1, 1, nHops * hopSize, fs)
+signal.setSignal(0, 0, 0, x)
+fileName = os.path.join(tempfile.mkdtemp(), 'excitation.npz')
+
+
+def makeModel(attackTimeSTL, outerEarFilter=ln.OME.ANSIS342007_FREEFIELD):
+    model = ln.DynamicLoudnessGM2002()
+    model.setAttackTimeSTL(attackTimeSTL)
+    model.setOuterEarFilter(outerEarFilter)
+    model.setOutputsToAggregate(['ShortTermLoudness'])
+    model.initialize(hop)
+    return model
+
+checkpoint = ln.StageCheckpoint('Excitation')
+print("Recorded: %r" % checkpoint.process(makeModel(0.022), signal, nHops,
+                                          fileName))
+print("Contents: %r" % sorted(np.load(fileName).keys()))
+
+# Sweep a downstream parameter
+for attackTimeSTL in [0.01, 0.05]:
+    replayed = makeModel(attackTimeSTL)
+    checkpoint.process(replayed, signal, nHops, fileName)
+    expected = makeModel(attackTimeSTL)
+    expected.processBlock(signal, nHops)
+    print("Attack %.2f s replayed: %r, identical: %r" % (
+        attackTimeSTL, checkpoint.isReplayed(),
+        np.array_equal(
+            replayed.getOutput('ShortTermLoudness').getAggregatedSignals(),
+            expected.getOutput('ShortTermLoudness').getAggregatedSignals())))
+
+diffuse = makeModel(0.022, ln.OME.ANSIS342007_DIFFUSEFIELD)
+print("Rejected for another outer ear: %r"
+      % (not checkpoint.isRecorded(diffuse, signal, nHops, fileName)))
+
+signal.setSignal(0, 0, 0, 2 * x)
+print("Rejected for another input: %r"
+      % (not checkpoint.isRecorded(makeModel(0.022), signal, nHops,
+                                   fileName)))
+os.remove(fileName)
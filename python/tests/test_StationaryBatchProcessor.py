@@ -0,0 +1,26 @@
+import numpy as np
+import loudness as ln
+
+'''
+Batch evaluation of a stationary model over many spectra should give the
+same outputs as processing each spectrum with a freshly initialised model.
+'''
+
+outputs = ['SpecificLoudness', 'Loudness']
+freqs = [np.array([250.0, 1000.0, 4000.0]),
+         np.array([100.0, 500.0, 1000.0, 2000.0, 8000.0])]
+levels = [np.random.uniform(0, 70, (200, 3)),
+          np.random.uniform(0, 70, (100, 5))]
+
+model = ln.StationaryLoudnessANSIS342007()
+extractor = ln.tools.extractors.StationaryLoudnessExtractor(model, outputs)
+batch = extractor.processBatch(freqs, levels)
+
+for grid in range(len(freqs)):
+    identical = True
+    for spectrum in range(levels[grid].shape[0]):
+        extractor.process(freqs[grid], levels[grid][spectrum])
+        for name in outputs:
+            identical &= np.array_equal(extractor.outputDict[name],
+                                        batch[grid][name][spectrum])
+    print("Grid %d identical: %r" % (grid, identical))
@@ -0,0 +1,28 @@
+import time
+import numpy as np
+import loudness as ln
+
+'''
+The native level solver should predict the same 40 phon contour as the
+Python fixed-step iterations, in a fraction of the time.
+'''
+
+
+def func(x):
+    return ln.soneToPhonMGB1997(float(x), True)
+
+model = ln.StationaryLoudnessANSIS342007()
+predictor = ln.tools.predictors.StationaryLoudnessContourPredictor(
+    model, 'Loudness', func, 40, tol=0.001, nIters=50)
+
+start = time.time()
+predictor.process()
+iterated = predictor.predictions.copy()
+print("Iterations: %.2f s" % (time.time() - start))
+
+start = time.time()
+predictor.solve()
+print("Solver: %.3f s" % (time.time() - start))
+print("All converged: %r" % np.all(predictor.converged))
+print("Maximum difference: %.4f dB" % np.max(np.abs(predictor.predictions -
+                                                   iterated)))
@@ -0,0 +1,25 @@
+import loudness as ln
+
+'''
+Modules share their constant tables through the TableRegistry, so
+initialising a second model with the same configuration should not add any
+tables. The tables are freed with the last model using them.
+'''
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, 32, 32000)
+
+nTablesBefore = ln.TableRegistry.getNTables()
+model = ln.DynamicLoudnessGM2002()
+model.initialize(hop)
+nTables = ln.TableRegistry.getNTables()
+print("Tables of one model: %d" % (nTables - nTablesBefore))
+
+other = ln.DynamicLoudnessGM2002()
+other.initialize(hop)
+print("Count unchanged by a second model: %r"
+      % (ln.TableRegistry.getNTables() == nTables))
+
+del model, other
+print("Tables freed with the models: %r"
+      % (ln.TableRegistry.getNTables() == nTablesBefore))
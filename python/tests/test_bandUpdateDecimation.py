@@ -0,0 +1,33 @@
+import numpy as np
+import loudness as ln
+
+'''
+Band update decimation recomputes the low-frequency bands of the
+multi-resolution spectrum every few hops. The bands of the longest windows
+are held in between, so short-term loudness of a steady tone should be
+close to the result with every band updated at every hop.
+'''
+
+fs = 32000
+hopSize = 32
+t = np.arange(int(fs * 1.0)) / float(fs)
+x = 0.05 * np.sin(2 * np.pi * 100 * t) + 0.02 * np.sin(2 * np.pi * 1000 * t)
+x = x.reshape((1, 1, x.size))
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+outputs = ['ShortTermLoudness']
+
+model = ln.DynamicLoudnessGM2002()
+model.initialize(hop)
+expected = model.processSignalArray(x, outputs)['ShortTermLoudness']
+
+for interpolated in [False, True]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setBandUpdatesDecimated(True)
+    model.setBandUpdatesInterpolated(interpolated)
+    model.initialize(hop)
+    result = model.processSignalArray(x, outputs)['ShortTermLoudness']
+    steady = t[::hopSize][:result.shape[0]] > 0.2
+    print("Interpolated %r, max relative deviation after 200 ms: %.2e" %
+          (interpolated, np.max(np.abs(result[steady] / expected[steady] - 1))))
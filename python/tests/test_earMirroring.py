@@ -0,0 +1,37 @@
+import numpy as np
+import loudness as ln
+
+'''
+Ear mirroring processes one ear of a diotic (dual-mono) frame and copies the
+result to the other, so output should be identical to the default model.
+A signal which differs across ears for part of its duration must also be
+unaffected.
+'''
+
+fs = 32000
+hopSize = 32
+t = np.arange(int(fs * 1.0)) / float(fs)
+left = 0.05 * np.sin(2 * np.pi * 1000 * t)
+right = left.copy()
+right[(t > 0.4) & (t < 0.6)] *= 0.5
+
+hop = ln.SignalBank()
+hop.initialize(1, 2, 1, hopSize, fs)
+outputs = ['SpecificLoudness', 'ShortTermLoudness']
+
+for name, x in [('Dual-mono', np.vstack((left, left))),
+                ('Partly dichotic', np.vstack((left, right)))]:
+    x = x.reshape((1, 2, x.shape[1]))
+
+    model = ln.DynamicLoudnessGM2002()
+    model.initialize(hop)
+    expected = model.processSignalArray(x, outputs)
+
+    model = ln.DynamicLoudnessGM2002()
+    model.setEarMirroringUsed(True)
+    model.initialize(hop)
+    result = model.processSignalArray(x, outputs)
+
+    for output in outputs:
+        print("%s, %s identical: %r" % (name, output,
+              np.array_equal(expected[output], result[output])))
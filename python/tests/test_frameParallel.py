@@ -0,0 +1,28 @@
+import numpy as np
+import loudness as ln
+
+'''
+Frame parallel processing computes the instantaneous loudness of a block of
+frames in parallel, followed by sequential temporal integration. The output
+should be identical to streaming.
+'''
+
+wav = '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+outputsOfInterest = ['InstantaneousLoudness', 'ShortTermLoudness']
+outputs = []
+for frameParallel in [False, True]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setFrameParallelUsed(frameParallel)
+    model.setFrameParallelBlockSize(100)
+    model.setNThreads(4)
+    model.setOutputsToAggregate(outputsOfInterest)
+    processor = ln.AudioFileProcessor(wav)
+    processor.initialize(model)
+    processor.processAllFrames(model)
+    print("Frame parallel active: %r" % model.isFrameParallelActive())
+    outputs.append([model.getOutput(name).getAggregatedSignals()
+                    for name in outputsOfInterest])
+
+for i, name in enumerate(outputsOfInterest):
+    print("Frame parallel %s identical: %r"
+          % (name, np.array_equal(outputs[0][i], outputs[1][i])))
@@ -0,0 +1,38 @@
+import numpy as np
+import loudness as ln
+
+'''
+Frame skipping reuses the excitation and specific loudness of silent and
+steady frames. Disabled tests give identical output, and with the default
+tolerance the short-term loudness should deviate very little.
+'''
+
+fs = 32000
+hopSize = 32
+t = np.arange(int(fs * 1.5)) / float(fs)
+x = 0.05 * np.sin(2 * np.pi * 1000 * t)
+x[t < 0.5] = 0
+x = x.reshape((1, 1, x.size))
+
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+
+model = ln.DynamicLoudnessGM2002()
+model.initialize(hop)
+expected = model.processSignalArray(x, ['ShortTermLoudness'])
+
+# Both tests disabled, then the defaults
+for threshold, tolerance in [(-np.inf, 0), (-20, 0.01)]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setFrameSkippingUsed(True)
+    model.setSilenceThreshold(threshold)
+    model.setSteadyStateTolerance(tolerance)
+    model.initialize(hop)
+    result = model.processSignalArray(x, ['ShortTermLoudness'])
+    deviation = np.abs(expected['ShortTermLoudness'] -
+                       result['ShortTermLoudness'])
+    print("Threshold %g dB, tolerance %g: %d silent and %d steady of %d "
+          "frames skipped, max deviation (sones) %.2e"
+          % (threshold, tolerance, model.getNSkippedSilentFrames(),
+             model.getNSkippedSteadyFrames(), model.getNGatedFrames(),
+             np.max(deviation)))
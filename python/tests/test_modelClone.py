@@ -0,0 +1,29 @@
+import numpy as np
+import loudness as ln
+
+'''
+A clone of an initialised model is initialised by copying its modules and
+should produce the same output as the original.
+'''
+
+outputsOfInterest = ['SpecificLoudness', 'ShortTermLoudness']
+
+model = ln.DynamicLoudnessCH2012()
+model.setOutputsToAggregate(outputsOfInterest)
+processor = ln.AudioFileProcessor(
+    '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+)
+processor.initialize(model)
+
+clone = model.clone()
+print("Clone initialised: %r" % clone.isInitialized())
+
+outputs = []
+for m in [model, clone]:
+    processor.processAllFrames(m)
+    outputs.append([m.getOutput(name).getAggregatedSignals()
+                    for name in outputsOfInterest])
+
+for i, name in enumerate(outputsOfInterest):
+    print("%s identical: %r"
+          % (name, np.array_equal(outputs[0][i], outputs[1][i])))
@@ -0,0 +1,45 @@
+import numpy as np
+import loudness as ln
+
+'''
+A stream interrupted by saving the model state and resumed on a new model
+with loadState() should produce the same output as an uninterrupted stream.
+'''
+
+fs = 32000
+hopSize = 32
+nHops = 400
+x = 0.05 * np.random.randn(nHops * hopSize)
+
+bank = ln.SignalBank()
+bank.initialize(1, 1, 1, hopSize, fs)
+
+
+def run(model, hops):
+    out = []
+    for hop in hops:
+        bank.setSignal(0, 0, 0, x[hop * hopSize:(hop + 1) * hopSize])
+        model.process(bank)
+        out.append(model.getOutput('ShortTermLoudness').getSample(0, 0, 0, 0))
+    return out
+
+reference = ln.DynamicLoudnessGM2002()
+reference.initialize(bank)
+expected = run(reference, range(nHops))
+
+first = ln.DynamicLoudnessGM2002()
+first.initialize(bank)
+resumed = run(first, range(nHops // 2))
+state = first.saveState()
+print("State size: %d values" % len(state))
+
+second = ln.DynamicLoudnessGM2002()
+second.initialize(bank)
+print("State loaded: %r" % second.loadState(state))
+resumed += run(second, range(nHops // 2, nHops))
+
+print("Resumed stream identical: %r" % np.array_equal(expected, resumed))
+
+other = ln.DynamicLoudnessCH2012()
+other.initialize(bank)
+print("State rejected by a different model: %r" % (not other.loadState(state)))
@@ -0,0 +1,26 @@
+import numpy as np
+import loudness as ln
+
+'''
+Filter bank style modules can split their channels across threads. The
+output should be identical to processing the channels sequentially.
+'''
+
+fs = 32000
+signal = ln.tools.sound.Sound.tone([1000], dur=1.0, fs=fs)
+signal.useDBSPL()
+signal.normalise(50, "RMS")
+signal.applyRamp(0.1)
+
+outputs = []
+for parallel in [False, True]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setParallelChannelsUsed(parallel)
+    model.setNThreads(4)
+    extractor = ln.tools.extractors.DynamicLoudnessExtractor(
+        model, fs, ["ShortTermLoudness"], 1, 1
+    )
+    extractor.process(signal.data)
+    outputs.append(extractor.outputDict["ShortTermLoudness"])
+
+print("ShortTermLoudness identical: %r" % np.array_equal(outputs[0], outputs[1]))
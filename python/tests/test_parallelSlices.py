@@ -0,0 +1,39 @@
+import numpy as np
+import loudness as ln
+
+'''
+Each module of DynamicLoudnessGM2002 processes several (source, ear) slices.
+Processing the slices in parallel should give the same output as processing
+them sequentially.
+'''
+
+outputsOfInterest = [
+    "ShortTermLoudness",
+    "ShortTermPartialLoudness",
+]
+
+fs = 32000
+signal = ln.tools.sound.Sound.tone([1000], dur=1.0, fs=fs)
+signal.useDBSPL()
+signal.normalise(50, "RMS")
+signal.applyRamp(0.1)
+
+signal2 = ln.tools.sound.Sound.tone([500], dur=1.0, fs=fs)
+signal2.useDBSPL()
+signal2.normalise(80, "RMS")
+signal2.applyRamp(0.1)
+
+outputs = []
+for parallel in [False, True]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setParallelSlicesUsed(parallel)
+    model.setNThreads(4)
+    extractor = ln.tools.extractors.DynamicLoudnessExtractor(
+        model, fs, outputsOfInterest, 4, 1
+    )
+    extractor.process([signal.data, signal2.data, signal.data, signal2.data])
+    outputs.append(extractor.outputDict)
+
+for name in outputsOfInterest:
+    print("%s identical: %r"
+          % (name, np.array_equal(outputs[0][name], outputs[1][name])))
@@ -0,0 +1,23 @@
+import numpy as np
+import loudness as ln
+
+'''
+Pipelined stages process consecutive hops on their own threads. Outputs lag
+behind the input, so they are collected by aggregation and should be
+identical to sequential processing.
+'''
+
+wav = '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+stl = []
+for pipelined in [False, True]:
+    model = ln.DynamicLoudnessGM2002()
+    model.setPipelineUsed(pipelined)
+    model.setOutputsToAggregate(['ShortTermLoudness'])
+    processor = ln.AudioFileProcessor(wav)
+    processor.initialize(model)
+    processor.processAllFrames(model)
+    print("Pipeline stages: %d" % model.getNPipelineStages())
+    stl.append(model.getOutput('ShortTermLoudness').getAggregatedSignals())
+
+print("Pipelined ShortTermLoudness identical: %r"
+      % np.array_equal(stl[0], stl[1]))
@@ -0,0 +1,50 @@
+import numpy as np
+import loudness as ln
+
+'''
+Processing a block of hops with processBlock() should give the same output
+as calling process() once per hop.
+'''
+
+fs = 32000
+hopSize = 32
+nHops = 500
+x = 0.05 * np.random.randn(nHops * hopSize)
+outputsOfInterest = ['SpecificLoudness', 'ShortTermLoudness']
+
+# One call per hop
+hop = ln.SignalBank()
+hop.initialize(1, 1, 1, hopSize, fs)
+model = ln.DynamicLoudnessGM2002()
+model.setOutputsToAggregate(outputsOfInterest)
+model.initialize(hop)
+for i in range(nHops):
+    hop.setSignal(0, 0, 0, x[i * hopSize:(i + 1) * hopSize])
+    model.process(hop)
+
+# One call for all hops
+block = ln.SignalBank()
+block.initialize(1, 1, 1, nHops * hopSize, fs)
+block.setSignal(0, 0, 0, x)
+blockModel = ln.DynamicLoudnessGM2002()
+blockModel.setBlockOutputs(outputsOfInterest)
+blockModel.initialize(hop)
+print("Block processed: %r" % blockModel.processBlock(block, nHops))
+
+for name in outputsOfInterest:
+    expected = model.getOutput(name).getAggregatedSignals()
+    result = blockModel.getBlockOutput(name).getAggregatedSignals()
+    print("%s identical: %r" % (name, np.array_equal(expected, result)))
+
+# The whole numpy signal in one call
+signalModel = ln.DynamicLoudnessGM2002()
+signalModel.initialize(hop)
+outputs = signalModel.processSignalArray(x.reshape((1, 1, x.size)),
+                                         outputsOfInterest)
+for name in outputsOfInterest:
+    expected = model.getOutput(name).getAggregatedSignals()
+    print("%s from signal array identical: %r"
+          % (name, np.array_equal(expected, outputs[name])))
+print("Block outputs left unset: %r"
+      % (signalModel.processBlock(block, nHops) and
+         len(signalModel.getBlockOutputNames()) == 0))
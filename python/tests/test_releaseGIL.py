@@ -0,0 +1,28 @@
+import numpy as np
+import loudness as ln
+from concurrent.futures import ThreadPoolExecutor
+
+'''
+The GIL is released while a model processes, so files processed by models on
+Python threads run concurrently and give the same output as sequential
+processing.
+'''
+
+wav = '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+
+
+def processFile(gainInDecibels):
+    model = ln.DynamicLoudnessCH2012()
+    model.setOutputsToAggregate(['ShortTermLoudness'])
+    processor = ln.AudioFileProcessor(wav)
+    processor.setGainInDecibels(gainInDecibels)
+    processor.initialize(model)
+    processor.processAllFrames(model)
+    return model.getOutput('ShortTermLoudness').getAggregatedSignals().copy()
+
+gains = [-10.0, -5.0, 0.0, 5.0]
+sequential = [processFile(gain) for gain in gains]
+with ThreadPoolExecutor(max_workers=len(gains)) as executor:
+    threaded = list(executor.map(processFile, gains))
+print("Python threads identical: %r"
+      % all(np.array_equal(a, b) for a, b in zip(sequential, threaded)))
@@ -0,0 +1,35 @@
+import numpy as np
+import loudness as ln
+
+'''
+Segments of a file are processed in parallel, each with a warm-up pre-roll.
+With a warm-up longer than the file, the stitched output matches sequential
+processing exactly. The deviation from a sequential reference run should
+equal the deviation of the stitched output. Sharing eight segments between
+two threads gives the same result as one thread per segment.
+'''
+
+wav = '../../wavs/pureTones/pureTone_1000Hz_40dBSPL_32000Hz.wav'
+outputs = []
+for nSegments, warmUp, nThreads in [(1, 0.2, 0), (4, 0.2, 0), (4, 10.0, 0),
+                                    (8, 0.2, 0), (8, 0.2, 2)]:
+    model = ln.DynamicLoudnessCH2012()
+    model.setOutputsToAggregate(['ShortTermLoudness', 'LongTermLoudness'])
+    processor = ln.AudioFileProcessor(wav)
+    processor.setSegmentWarmUpDuration(warmUp)
+    processor.setSequentialReferenceUsed(True)
+    processor.setNThreads(nThreads)
+    processor.initialize(model)
+    processor.processAllFramesInSegments(model, nSegments)
+    print("Segments: %d, threads: %d, seam deviation estimate: %g, "
+          "deviation from sequential: %g"
+          % (nSegments, nThreads, processor.getMaxSeamDeviation(),
+             processor.getMaxSequentialDeviation()))
+    outputs.append(model.getOutput('LongTermLoudness').getAggregatedSignals())
+
+print("Segmented LongTermLoudness max deviation (0.2 s warm-up): %g"
+      % np.max(np.abs(outputs[0] - outputs[1])))
+print("Segmented LongTermLoudness identical (10 s warm-up): %r"
+      % np.array_equal(outputs[0], outputs[2]))
+print("Eight segments on two threads identical: %r"
+      % np.array_equal(outputs[3], outputs[4]))
@@ -31,22 +31,27 @@
 #include "../modules/MultiSourceDoubleRoexBank.h"
 #include "../modules/SpecificPartialLoudnessCHGM2011.h"
 #include "../modules/BinauralInhibitionMG2007.h"
-#include "../modules/InstantaneousLoudness.h"
-#include "../modules/ARAverager.h"
+#include "../modules/LoudnessIntegrator.h"
 #include "DynamicLoudnessCH2012.h"
 
 namespace loudness{
 
     DynamicLoudnessCH2012::DynamicLoudnessCH2012(const string& pathToFilterCoefs) :
         Model("DynamicLoudnessCH2012", true),
-        pathToFilterCoefs_(pathToFilterCoefs)
+        pathToFilterCoefs_(pathToFilterCoefs),
+        areBandUpdatesDecimated_(false),
+        areBandUpdatesInterpolated_(false),
+        minimumWindowOverlap_(0.875)
     {
         configureModelParameters("Faster");
     }
 
     DynamicLoudnessCH2012::DynamicLoudnessCH2012() :
         Model("DynamicLoudnessCH2012", true),
-        pathToFilterCoefs_("")
+        pathToFilterCoefs_(""),
+        areBandUpdatesDecimated_(false),
+        areBandUpdatesInterpolated_(false),
+        minimumWindowOverlap_(0.875)
     {
         configureModelParameters("Faster");
     }
@@ -55,6 +60,26 @@ namespace loudness{
     {
     }
 
+    Model* DynamicLoudnessCH2012::copyConfiguration() const
+    {
+        return new DynamicLoudnessCH2012(*this);
+    }
+
+    void DynamicLoudnessCH2012::setBandUpdatesDecimated(bool areBandUpdatesDecimated)
+    {
+        areBandUpdatesDecimated_ = areBandUpdatesDecimated;
+    }
+
+    void DynamicLoudnessCH2012::setMinimumWindowOverlap(Real minimumWindowOverlap)
+    {
+        minimumWindowOverlap_ = minimumWindowOverlap;
+    }
+
+    void DynamicLoudnessCH2012::setBandUpdatesInterpolated(bool areBandUpdatesInterpolated)
+    {
+        areBandUpdatesInterpolated_ = areBandUpdatesInterpolated;
+    }
+
     void DynamicLoudnessCH2012::setFirstSampleAtWindowCentre(bool isFirstSampleAtWindowCentre)
     {
         isFirstSampleAtWindowCentre_ = isFirstSampleAtWindowCentre;
@@ -268,10 +293,14 @@ namespace loudness{
             modules_.push_back(unique_ptr<Module>
                     (new Window(Window::HANN, windowSizeSamples, true)));
 
-            modules_.push_back(unique_ptr<Module> 
-                    (new PowerSpectrum(bandFreqsHz,
-                                       windowSizeSamples,
-                                       isSpectrumSampledUniformly_)));
+            PowerSpectrum* powerSpectrum = new PowerSpectrum(bandFreqsHz,
+                    windowSizeSamples,
+                    isSpectrumSampledUniformly_);
+            powerSpectrum -> setBandUpdatesDecimated(areBandUpdatesDecimated_,
+                    minimumWindowOverlap_,
+                    areBandUpdatesInterpolated_ ? PowerSpectrum::LINEAR :
+                    PowerSpectrum::HOLD);
+            modules_.push_back(unique_ptr<Module> (powerSpectrum));
         }
 
         /*
@@ -293,6 +322,7 @@ namespace loudness{
         }
 
         int lastSpectrumIdx = modules_.size()-1;
+        outputModules_["WeightedSpectrum"] = modules_[lastSpectrumIdx].get();
 
         /*
          * Roex filters
@@ -336,22 +366,18 @@ namespace loudness{
         }
         outputModules_["SpecificLoudness"] = modules_.back().get();
 
-        modules_.push_back(unique_ptr<Module>
-                (new InstantaneousLoudness(instantaneousLoudnessFactor, 
-                                           isPresentationDiotic_)));
-        outputModules_["InstantaneousLoudness"] = modules_.back().get();
-
-        modules_.push_back(unique_ptr<Module>
-                (new ARAverager(attackTimeSTL_, releaseTimeSTL_)));
-        outputModules_["ShortTermLoudness"] = modules_.back().get();
-
-        modules_.push_back(unique_ptr<Module>
-                (new ARAverager(attackTimeLTL_, releaseTimeLTL_)));
-        outputModules_["LongTermLoudness"] = modules_.back().get();
-        
         //configure targets
         configureLinearTargetModuleChain();
 
+        configureTemporalIntegration(new LoudnessIntegrator(
+                                         instantaneousLoudnessFactor,
+                                         isPresentationDiotic_,
+                                         attackTimeSTL_,
+                                         releaseTimeSTL_,
+                                         attackTimeLTL_,
+                                         releaseTimeLTL_),
+                                     "Loudness");
+
         if ((input.getNSources() > 1) && (isPartialLoudnessUsed_))
         {
             LOUDNESS_DEBUG(name_ 
@@ -383,20 +409,16 @@ namespace loudness{
 
             outputModules_["SpecificPartialLoudness"] = modules_.back().get();
 
-            modules_.push_back(unique_ptr<Module> 
-                    (new InstantaneousLoudness(1.0, isPresentationDiotic_)));
-            outputModules_["InstantaneousPartialLoudness"] = modules_.back().get();
-
-            modules_.push_back(unique_ptr<Module>
-                (new ARAverager(attackTimeSTL_, releaseTimeSTL_)));
-            outputModules_["ShortTermPartialLoudness"] = modules_.back().get();
-
-            modules_.push_back(unique_ptr<Module>
-                    (new ARAverager(attackTimeLTL_, releaseTimeLTL_)));
-            outputModules_["LongTermPartialLoudness"] = modules_.back().get();
-
             // configure targets for second (parallel) chain
             configureLinearTargetModuleChain(moduleIdx);
+
+            configureTemporalIntegration(new LoudnessIntegrator(1.0,
+                                             isPresentationDiotic_,
+                                             attackTimeSTL_,
+                                             releaseTimeSTL_,
+                                             attackTimeLTL_,
+                                             releaseTimeLTL_),
+                                         "PartialLoudness");
         }
 
         return 1;
@@ -73,6 +73,7 @@ namespace loudness{
      * this is true;
      *
      * OUTPUTS:
+     *  - "WeightedSpectrum"
      *  - "SpecificLoudness"
      *  - "InstantaneousLoudness"
      *  - "ShortTermLoudness"
@@ -121,6 +122,22 @@ namespace loudness{
 
             void setHoppingGoertzelDFTUsed (bool isHoppingGoertzelDFTUsed);
 
+            /**
+             * @brief Sets whether the bands of the multi-resolution spectrum
+             * are recomputed less often than every hop, longer windows less
+             * often (see PowerSpectrum::setBandUpdatesDecimated()). Default
+             * is false.
+             */
+            void setBandUpdatesDecimated(bool areBandUpdatesDecimated);
+
+            /** Sets the minimum overlap of successive windows of a band when
+             * band updates are decimated. Default is 0.875. */
+            void setMinimumWindowOverlap(Real minimumWindowOverlap);
+
+            /** Sets whether bands are interpolated, rather than held, between
+             * decimated updates. Default is false. */
+            void setBandUpdatesInterpolated(bool areBandUpdatesInterpolated);
+
             void setExcitationPatternInterpolated(bool isExcitationPatternInterpolated);
 
             void setInterpolationCubic(bool isInterpolationCubic);
@@ -153,6 +170,7 @@ namespace loudness{
             void setReleaseTimeSTL (Real releaseTimeSTL);
 
         private:
+            virtual Model* copyConfiguration() const;
             virtual bool initializeInternal(const SignalBank &input);
 
             string pathToFilterCoefs_;
@@ -166,6 +184,8 @@ namespace loudness{
             bool isSpecificLoudnessOutput_, isBinauralInhibitionUsed_;
             bool isFirstSampleAtWindowCentre_;
             bool isPartialLoudnessUsed_, isWindowSpecGM02_;
+            bool areBandUpdatesDecimated_, areBandUpdatesInterpolated_;
+            Real minimumWindowOverlap_;
             OME::Filter outerEarFilter_, middleEarFilter_;
     }; 
 }
@@ -34,22 +34,29 @@
 #include "../modules/SpecificPartialLoudnessMGB1997.h"
 #include "../modules/SpecificLoudnessANSIS342007.h"
 #include "../modules/BinauralInhibitionMG2007.h"
-#include "../modules/InstantaneousLoudness.h"
-#include "../modules/ARAverager.h"
+#include "../modules/LoudnessIntegrator.h"
+#include "../modules/ARAveragerBank.h"
+#include "../modules/ChannelSelector.h"
 #include "DynamicLoudnessGM2002.h"
 
 namespace loudness{
 
     DynamicLoudnessGM2002::DynamicLoudnessGM2002(const string& pathToFilterCoefs) :
         Model("DynamicLoudnessGM2002", true),
-        pathToFilterCoefs_(pathToFilterCoefs)
+        pathToFilterCoefs_(pathToFilterCoefs),
+        areBandUpdatesDecimated_(false),
+        areBandUpdatesInterpolated_(false),
+        minimumWindowOverlap_(0.875)
     {
         configureModelParameters("FasterAndRecent");
     }
 
     DynamicLoudnessGM2002::DynamicLoudnessGM2002() :
         Model("DynamicLoudnessGM2002", true),
-        pathToFilterCoefs_("")
+        pathToFilterCoefs_(""),
+        areBandUpdatesDecimated_(false),
+        areBandUpdatesInterpolated_(false),
+        minimumWindowOverlap_(0.875)
     {
         configureModelParameters("FasterAndRecent");
     }
@@ -58,6 +65,26 @@ namespace loudness{
     {
     }
 
+    Model* DynamicLoudnessGM2002::copyConfiguration() const
+    {
+        return new DynamicLoudnessGM2002(*this);
+    }
+
+    void DynamicLoudnessGM2002::setBandUpdatesDecimated(bool areBandUpdatesDecimated)
+    {
+        areBandUpdatesDecimated_ = areBandUpdatesDecimated;
+    }
+
+    void DynamicLoudnessGM2002::setMinimumWindowOverlap(Real minimumWindowOverlap)
+    {
+        minimumWindowOverlap_ = minimumWindowOverlap;
+    }
+
+    void DynamicLoudnessGM2002::setBandUpdatesInterpolated(bool areBandUpdatesInterpolated)
+    {
+        areBandUpdatesInterpolated_ = areBandUpdatesInterpolated;
+    }
+
     void DynamicLoudnessGM2002::setPartialLoudnessUsed(bool isPartialLoudnessUsed)
     {
         isPartialLoudnessUsed_ = isPartialLoudnessUsed;
@@ -157,29 +184,72 @@ namespace loudness{
         isSpecificLoudnessANSIS342007_ = isSpecificLoudnessANSIS342007;
     }
 
-    void DynamicLoudnessGM2002::configureSmoothingTimes(const string& author)
+    void DynamicLoudnessGM2002::getSmoothingTimes(const string& author,
+            Real& attackTimeSTL,
+            Real& releaseTimeSTL,
+            Real& attackTimeLTL,
+            Real& releaseTimeLTL) const
     {
-        if (author == "GM2002")
-        {
-            attackTimeSTL_ = -0.001/log(1-0.045);
-            releaseTimeSTL_ = -0.001/log(1-0.02);
-            attackTimeLTL_ = -0.001/log(1-0.01);
-            releaseTimeLTL_ = -0.001/log(1-0.0005);
-            LOUDNESS_DEBUG(name_ << ": Time-constants from 2002 paper");
-        }
-        else if (author == "MGS2003")
+        attackTimeSTL = -0.001/log(1-0.045);
+        releaseTimeSTL = -0.001/log(1-0.02);
+        attackTimeLTL = -0.001/log(1-0.01);
+        if (author == "MGS2003")
         {
-            attackTimeSTL_ = -0.001/log(1-0.045);
-            releaseTimeSTL_  = -0.001/log(1-0.02);
-            attackTimeLTL_ = -0.001/log(1-0.01);
-            releaseTimeLTL_ = -0.001/log(1-0.005);
+            releaseTimeLTL = -0.001/log(1-0.005);
             LOUDNESS_DEBUG(name_ << ": Modified time-constants from 2003 paper");
         }
         else
         {
-            configureSmoothingTimes("GM2002");
+            releaseTimeLTL = -0.001/log(1-0.0005);
+            LOUDNESS_DEBUG(name_ << ": Time-constants from 2002 paper");
         }
     }
+
+    void DynamicLoudnessGM2002::configureSmoothingTimes(const string& author)
+    {
+        getSmoothingTimes(author,
+                attackTimeSTL_,
+                releaseTimeSTL_,
+                attackTimeLTL_,
+                releaseTimeLTL_);
+    }
+
+    void DynamicLoudnessGM2002::addSmoothingTimes(const string& name,
+            Real attackTimeSTL,
+            Real releaseTimeSTL,
+            Real attackTimeLTL,
+            Real releaseTimeLTL)
+    {
+        smoothingNames_.push_back(name);
+        smoothingAttackTimesSTL_.push_back(attackTimeSTL);
+        smoothingReleaseTimesSTL_.push_back(releaseTimeSTL);
+        smoothingAttackTimesLTL_.push_back(attackTimeLTL);
+        smoothingReleaseTimesLTL_.push_back(releaseTimeLTL);
+    }
+
+    void DynamicLoudnessGM2002::addSmoothingTimes(const string& author)
+    {
+        Real attackTimeSTL, releaseTimeSTL, attackTimeLTL, releaseTimeLTL;
+        getSmoothingTimes(author,
+                attackTimeSTL,
+                releaseTimeSTL,
+                attackTimeLTL,
+                releaseTimeLTL);
+        addSmoothingTimes(author,
+                attackTimeSTL,
+                releaseTimeSTL,
+                attackTimeLTL,
+                releaseTimeLTL);
+    }
+
+    void DynamicLoudnessGM2002::clearSmoothingTimes()
+    {
+        smoothingNames_.clear();
+        smoothingAttackTimesSTL_.clear();
+        smoothingReleaseTimesSTL_.clear();
+        smoothingAttackTimesLTL_.clear();
+        smoothingReleaseTimesLTL_.clear();
+    }
     
     void DynamicLoudnessGM2002::configureModelParameters(const string& setName)
     {
@@ -349,10 +419,14 @@ namespace loudness{
             modules_.push_back(unique_ptr<Module>
                     (new Window(Window::HANN, windowSizeSamples, true)));
 
-            modules_.push_back(unique_ptr<Module> 
-                    (new PowerSpectrum(bandFreqsHz,
-                                       windowSizeSamples,
-                                       isSpectrumSampledUniformly_)));
+            PowerSpectrum* powerSpectrum = new PowerSpectrum(bandFreqsHz,
+                    windowSizeSamples,
+                    isSpectrumSampledUniformly_);
+            powerSpectrum -> setBandUpdatesDecimated(areBandUpdatesDecimated_,
+                    minimumWindowOverlap_,
+                    areBandUpdatesInterpolated_ ? PowerSpectrum::LINEAR :
+                    PowerSpectrum::HOLD);
+            modules_.push_back(unique_ptr<Module> (powerSpectrum));
         }
 
         /*
@@ -376,6 +450,7 @@ namespace loudness{
             }
         }
         int lastSpectrumIdx = modules_.size()-1;
+        outputModules_["WeightedSpectrum"] = modules_[lastSpectrumIdx].get();
 
         /*
          * Roex filters
@@ -413,29 +488,19 @@ namespace loudness{
         }
         outputModules_["SpecificLoudness"] = modules_.back().get();
 
-        /*
-        * Instantaneous loudness
-        */   
-        modules_.push_back(unique_ptr<Module> 
-                (new InstantaneousLoudness(1.0, isPresentationDiotic_)));
-        outputModules_["InstantaneousLoudness"] = modules_.back().get();
+        //configure targets
+        configureLinearTargetModuleChain();
 
         /*
-         * Short-term loudness
+         * Instantaneous, short-term and long-term loudness
          */
-        modules_.push_back(unique_ptr<Module>
-                (new ARAverager(attackTimeSTL_, releaseTimeSTL_)));
-        outputModules_["ShortTermLoudness"] = modules_.back().get();
-
-        /*
-         * Long-term loudness
-         */
-        modules_.push_back(unique_ptr<Module>
-                (new ARAverager(attackTimeLTL_, releaseTimeLTL_)));
-        outputModules_["LongTermLoudness"] = modules_.back().get();
-
-        //configure targets
-        configureLinearTargetModuleChain();
+        configureTemporalIntegration(new LoudnessIntegrator(1.0,
+                                         isPresentationDiotic_,
+                                         attackTimeSTL_,
+                                         releaseTimeSTL_,
+                                         attackTimeLTL_,
+                                         releaseTimeLTL_),
+                                     "Loudness");
 
         // Masking conditions
         if ((input.getNSources() > 1) && (isPartialLoudnessUsed_))
@@ -463,29 +528,58 @@ namespace loudness{
                 modules_.push_back(unique_ptr<Module> (new BinauralInhibitionMG2007));
             outputModules_["SpecificPartialLoudness"] = modules_.back().get();
 
-            /*
-             * Instantaneous partial loudness
-             */
-            modules_.push_back(unique_ptr<Module> 
-                    (new InstantaneousLoudness(1.0, isPresentationDiotic_)));
-            outputModules_["InstantaneousPartialLoudness"] = modules_.back().get();
+            // configure targets for second (parallel) chain
+            configureLinearTargetModuleChain(moduleIdx);
 
             /*
-             * Short-term partial loudness
+             * Instantaneous, short-term and long-term partial loudness
              */
+            configureTemporalIntegration(new LoudnessIntegrator(1.0,
+                                             isPresentationDiotic_,
+                                             attackTimeSTL_,
+                                             releaseTimeSTL_,
+                                             attackTimeLTL_,
+                                             releaseTimeLTL_),
+                                         "PartialLoudness");
+        }
+
+        /*
+         * Additional smoothing variants, all computed in one pass
+         */
+        if (!smoothingNames_.empty())
+        {
+            // instantaneous loudness has one channel, so pair k of each
+            // bank is channel k
+            int nPairs = (int)smoothingNames_.size();
+
             modules_.push_back(unique_ptr<Module>
-                    (new ARAverager(attackTimeSTL_, releaseTimeSTL_)));
-            outputModules_["ShortTermPartialLoudness"] = modules_.back().get();
+                    (new ARAveragerBank(smoothingAttackTimesSTL_,
+                                        smoothingReleaseTimesSTL_)));
+            Module* ptrToSTLBank = modules_.back().get();
+            outputModules_["InstantaneousLoudness"] -> addTargetModule
+                                                       (*ptrToSTLBank);
 
-            /*
-             * Long-term partial loudness
-             */
             modules_.push_back(unique_ptr<Module>
-                    (new ARAverager(attackTimeLTL_, releaseTimeLTL_)));
-            outputModules_["LongTermPartialLoudness"] = modules_.back().get();
+                    (new ARAveragerBank(smoothingAttackTimesLTL_,
+                                        smoothingReleaseTimesLTL_,
+                                        true)));
+            Module* ptrToLTLBank = modules_.back().get();
+            ptrToSTLBank -> addTargetModule (*ptrToLTLBank);
 
-            // configure targets for second (parallel) chain
-            configureLinearTargetModuleChain(moduleIdx);
+            for (int k = 0; k < nPairs; ++k)
+            {
+                modules_.push_back(unique_ptr<Module>
+                        (new ChannelSelector(k, 1)));
+                ptrToSTLBank -> addTargetModule (*modules_.back());
+                outputModules_["ShortTermLoudness" + smoothingNames_[k]] =
+                    modules_.back().get();
+
+                modules_.push_back(unique_ptr<Module>
+                        (new ChannelSelector(k, 1)));
+                ptrToLTLBank -> addTargetModule (*modules_.back());
+                outputModules_["LongTermLoudness" + smoothingNames_[k]] =
+                    modules_.back().get();
+            }
         }
 
         return 1;
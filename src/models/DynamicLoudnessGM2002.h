@@ -82,12 +82,15 @@ namespace loudness{
      * modes, this is true.
      *
      * OUTPUTS:
+     *  - "WeightedSpectrum"
      *  - "Excitation"
      *  - "SpecificLoudness"
      *  - "InstantaneousLoudness"
      *  - "ShortTermLoudness"
      *  - "LongTermLoudness"
      *  - "PeakShortTermLoudness" (optional)
+     *  - "ShortTermLoudness<name>" and "LongTermLoudness<name>" for each set
+     *    of time-constants added with addSmoothingTimes() (optional)
      *
      * REFERENCES:
      *
@@ -157,6 +160,22 @@ namespace loudness{
 
             void setSpectralResolutionDoubled(bool isSpectralResolutionDoubled);
 
+            /**
+             * @brief Sets whether the bands of the multi-resolution spectrum
+             * are recomputed less often than every hop, longer windows less
+             * often (see PowerSpectrum::setBandUpdatesDecimated()). Default
+             * is false.
+             */
+            void setBandUpdatesDecimated(bool areBandUpdatesDecimated);
+
+            /** Sets the minimum overlap of successive windows of a band when
+             * band updates are decimated. Default is 0.875. */
+            void setMinimumWindowOverlap(Real minimumWindowOverlap);
+
+            /** Sets whether bands are interpolated, rather than held, between
+             * decimated updates. Default is false. */
+            void setBandUpdatesInterpolated(bool areBandUpdatesInterpolated);
+
             void setPresentationDiotic(bool isPresentationDiotic);
 
             void setBinauralInhibitionUsed(bool isBinauralInhibitionUsed);
@@ -187,8 +206,36 @@ namespace loudness{
 
             void configureSmoothingTimes(const string& author);
 
+            /**
+             * @brief Adds a set of short-term and long-term loudness
+             * time-constants, giving the extra outputs
+             * "ShortTermLoudness<name>" and "LongTermLoudness<name>".
+             *
+             * All added sets are applied to the instantaneous loudness in a
+             * single pass using ARAveragerBank modules, so one run produces
+             * every smoothing variant.
+             */
+            void addSmoothingTimes(const string& name,
+                    Real attackTimeSTL,
+                    Real releaseTimeSTL,
+                    Real attackTimeLTL,
+                    Real releaseTimeLTL);
+
+            /** Adds the time-constants used by author (see
+             * configureSmoothingTimes()) under the name author. */
+            void addSmoothingTimes(const string& author);
+
+            /** Removes all sets added with addSmoothingTimes(). */
+            void clearSmoothingTimes();
+
         private:
+            virtual Model* copyConfiguration() const;
             virtual bool initializeInternal(const SignalBank &input);
+            void getSmoothingTimes(const string& author,
+                    Real& attackTimeSTL,
+                    Real& releaseTimeSTL,
+                    Real& attackTimeLTL,
+                    Real& releaseTimeLTL) const;
 
             Real filterSpacingInCams_, compressionCriterionInCams_;
             Real attackTimeSTL_, releaseTimeSTL_;
@@ -200,7 +247,12 @@ namespace loudness{
             bool isSpecificLoudnessANSIS342007_, isFirstSampleAtWindowCentre_;
             bool isPartialLoudnessUsed_;
             string pathToFilterCoefs_;
+            vector<string> smoothingNames_;
+            RealVec smoothingAttackTimesSTL_, smoothingReleaseTimesSTL_;
+            RealVec smoothingAttackTimesLTL_, smoothingReleaseTimesLTL_;
             OME::Filter outerEarFilter_, middleEarFilter_;
+            bool areBandUpdatesDecimated_, areBandUpdatesInterpolated_;
+            Real minimumWindowOverlap_;
     }; 
 }
 
@@ -44,6 +44,11 @@ namespace loudness{
     StationaryLoudnessANSIS342007::~StationaryLoudnessANSIS342007()
     {}
 
+    Model* StationaryLoudnessANSIS342007::copyConfiguration() const
+    {
+        return new StationaryLoudnessANSIS342007(*this);
+    }
+
     void StationaryLoudnessANSIS342007::setPresentationDiotic(bool isPresentationDiotic)
     {
         isPresentationDiotic_ = isPresentationDiotic;
@@ -107,6 +107,7 @@ namespace loudness{
             void setSpecificLoudnessANSIS342007(bool isSpecificLoudnessANSIS342007_);
 
         private:
+            virtual Model* copyConfiguration() const;
             virtual bool initializeInternal(const SignalBank &input);
 
             Real filterSpacingInCams_;
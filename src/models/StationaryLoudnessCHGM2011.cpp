@@ -42,6 +42,11 @@ namespace loudness{
     StationaryLoudnessCHGM2011::~StationaryLoudnessCHGM2011()
     {}
 
+    Model* StationaryLoudnessCHGM2011::copyConfiguration() const
+    {
+        return new StationaryLoudnessCHGM2011(*this);
+    }
+
     void StationaryLoudnessCHGM2011::setPresentationDiotic(bool isPresentationDiotic)
     {
         isPresentationDiotic_ = isPresentationDiotic;
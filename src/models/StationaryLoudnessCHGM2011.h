@@ -86,6 +86,7 @@ namespace loudness{
             void setPartialLoudnessUsed (bool setPartialLoudnessUsed);
 
         private:
+            virtual Model* copyConfiguration() const;
             virtual bool initializeInternal(const SignalBank &input);
 
             Real filterSpacingInCams_;
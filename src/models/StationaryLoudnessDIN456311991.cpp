@@ -34,6 +34,11 @@ namespace loudness{
     StationaryLoudnessDIN456311991::~StationaryLoudnessDIN456311991()
     {}
 
+    Model* StationaryLoudnessDIN456311991::copyConfiguration() const
+    {
+        return new StationaryLoudnessDIN456311991(*this);
+    }
+
     void StationaryLoudnessDIN456311991::setOuterEarFilter(MainLoudnessDIN456311991::OuterEarFilter outerEarFilter)
     {
         outerEarFilter_ = outerEarFilter;
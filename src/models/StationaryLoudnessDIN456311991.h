@@ -75,6 +75,7 @@ namespace loudness{
             void setOuterEarFilter(MainLoudnessDIN456311991::OuterEarFilter outerEarFilter);
 
         private:
+            virtual Model* copyConfiguration() const;
             virtual bool initializeInternal(const SignalBank &input);
 
             MainLoudnessDIN456311991::OuterEarFilter outerEarFilter_;
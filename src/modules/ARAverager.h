@@ -54,6 +54,8 @@ namespace loudness{
 
         virtual ~ARAverager();
 
+        virtual Module* clone() const {return new ARAverager(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
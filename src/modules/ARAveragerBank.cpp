@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "ARAveragerBank.h"
+
+namespace loudness{
+
+    ARAveragerBank::ARAveragerBank(const RealVec &attackTimes,
+            const RealVec &releaseTimes,
+            bool isInputSplit) :
+        Module("ARAveragerBank"),
+        attackTimes_(attackTimes),
+        releaseTimes_(releaseTimes),
+        isInputSplit_(isInputSplit),
+        nChannelsPerPair_(0)
+    {
+        LOUDNESS_DEBUG(name_ << ": Constructed.");
+    }
+
+    ARAveragerBank::~ARAveragerBank()
+    {};
+
+    int ARAveragerBank::getNPairs() const
+    {
+        return (int)attackTimes_.size();
+    }
+
+    bool ARAveragerBank::initializeInternal(const SignalBank &input)
+    {
+        int nPairs = getNPairs();
+        if ((nPairs == 0) || ((int)releaseTimes_.size() != nPairs))
+        {
+            LOUDNESS_ERROR(name_ << ": Need the same (nonzero) number of "
+                    << "attack and release times.");
+            return 0;
+        }
+
+        nChannelsPerPair_ = input.getNChannels();
+        if (isInputSplit_)
+        {
+            if (input.getNChannels() % nPairs)
+            {
+                LOUDNESS_ERROR(name_ << ": Number of input channels is not "
+                        << "a multiple of the number of pairs.");
+                return 0;
+            }
+            nChannelsPerPair_ /= nPairs;
+        }
+
+        //filter coefficients
+        attackCoefs_.resize(nPairs);
+        releaseCoefs_.resize(nPairs);
+        for (int k = 0; k < nPairs; ++k)
+        {
+            attackCoefs_[k] = 1 - exp(-1.0 / (input.getFrameRate() *
+                        attackTimes_[k]));
+            releaseCoefs_[k] = 1 - exp(-1.0 / (input.getFrameRate() *
+                        releaseTimes_[k]));
+            LOUDNESS_DEBUG(name_ << ": Pair " << k
+                    << ". Attack coefficient: " << attackCoefs_[k]
+                    << ". Release coefficient: " << releaseCoefs_[k]);
+        }
+
+        //output SignalBank: one block of channels per pair
+        output_.initialize(input.getNSources(),
+                input.getNEars(),
+                nChannelsPerPair_ * nPairs,
+                input.getNSamples(),
+                input.getFs());
+        output_.setFrameRate(input.getFrameRate());
+        for (int k = 0; k < nPairs; ++k)
+        {
+            for (int chn = 0; chn < nChannelsPerPair_; ++chn)
+            {
+                int inChn = isInputSplit_ ? k * nChannelsPerPair_ + chn : chn;
+                output_.setCentreFreq(k * nChannelsPerPair_ + chn,
+                        input.getCentreFreq(inChn));
+            }
+        }
+
+        state_.initialize(input.getNSources(),
+                input.getNEars(),
+                nChannelsPerPair_,
+                nPairs,
+                input.getFs());
+
+        return 1;
+    }
+
+    void ARAveragerBank::processInternal(const SignalBank &input)
+    {       
+        int nPairs = getNPairs();
+        int nSamples = input.getNSamples();
+        int pairStride = nChannelsPerPair_ * nSamples;
+        int inputPairStride = isInputSplit_ ? pairStride : 0;
+        const Real* attackCoefs = attackCoefs_.data();
+        const Real* releaseCoefs = releaseCoefs_.data();
+
+        for (int src = 0; src < input.getNSources(); src++)
+        {
+            for (int ear = 0; ear < input.getNEars(); ++ear)
+            {
+                for (int chn = 0; chn < nChannelsPerPair_; ++chn)
+                {
+                    /* y[k * pairStride] holds channel chn of pair k, and
+                     * each pair reads either the shared input channel or its
+                     * own block */
+                    const Real* x = input.getSignalReadPointer(src,
+                            ear, chn, 0);
+                    Real* y = output_.getSignalWritePointer(src,
+                            ear, chn, 0);
+                    Real* state = state_.getSignalWritePointer(src,
+                            ear, chn, 0);
+
+                    for (int smp = 0; smp < nSamples; ++smp)
+                    {
+                        for (int k = 0; k < nPairs; ++k)
+                        {
+                            Real xk = x[k * inputPairStride + smp];
+                            Real coef = (xk > state[k]) ?
+                                attackCoefs[k] : releaseCoefs[k];
+                            state[k] += coef * (xk - state[k]);
+                        }
+                        for (int k = 0; k < nPairs; ++k)
+                            y[k * pairStride + smp] = state[k];
+                    }
+                }
+            }
+        }
+    }
+
+    void ARAveragerBank::resetInternal()
+    {
+        state_.zeroSignals();
+    }
+
+    void ARAveragerBank::saveStateInternal(RealVec &state) const
+    {
+        appendState(state, state_);
+    }
+
+    bool ARAveragerBank::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return extractState(state, pos, state_);
+    }
+
+    void ARAveragerBank::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {isInputSplit_, nChannelsPerPair_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(attackTimes_.data(), attackTimes_.size() * sizeof(Real),
+                hash);
+        hashBytes(releaseTimes_.data(), releaseTimes_.size() * sizeof(Real),
+                hash);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef ARAVERAGERBANK_H
+#define ARAVERAGERBANK_H
+
+#include "../support/Module.h"
+
+namespace loudness{
+
+    /**
+     * @class ARAveragerBank
+     *
+     * @brief Applies K first-order attack/release low-pass filters to the
+     * same input in a single pass.
+     *
+     * Each attack/release pair gives the same result as an ARAverager with
+     * those time-constants. The output SignalBank holds one block of input
+     * channels per pair, so channel k * nChannels + chn of the output is
+     * channel chn of the input filtered by pair k. The K filter states of
+     * each input channel are held contiguously, updated together and then
+     * scattered to the output blocks.
+     *
+     * If isInputSplit is true, the input is expected to come from another
+     * ARAveragerBank with the same number of pairs and pair k is applied only
+     * to block k of the input. This allows long-term loudness to be computed
+     * from K short-term loudness signals in one pass.
+     *
+     * Use ChannelSelector to access the output of a single pair.
+     *
+     * @sa ARAverager, ChannelSelector
+     */
+    class ARAveragerBank : public Module
+    {
+    public:
+ 
+        /** Constructs an ARAveragerBank with attackTimes and releaseTimes in
+         * seconds. Both must have the same size. */
+        ARAveragerBank(const RealVec &attackTimes,
+                const RealVec &releaseTimes,
+                bool isInputSplit = false);
+
+        virtual ~ARAveragerBank();
+
+        virtual Module* clone() const {return new ARAveragerBank(*this);};
+
+        /** Returns the number of attack/release pairs. */
+        int getNPairs() const;
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
+        virtual void hashConfiguration(unsigned long long& hash) const;
+
+        RealVec attackTimes_, releaseTimes_;
+        RealVec attackCoefs_, releaseCoefs_;
+        bool isInputSplit_;
+        int nChannelsPerPair_;
+
+        /* filter states, the K pairs of each input channel are held as the
+         * samples of one channel */
+        SignalBank state_;
+    };
+}
+
+#endif
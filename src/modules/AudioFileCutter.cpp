@@ -199,6 +199,17 @@ namespace loudness{
         }
     }
 
+    void AudioFileCutter::seekFrame(int frame)
+    {
+        if(sndFile_)
+        {
+            bufferIdx_ = audioBufferSize_;
+            sf_count_t sample = (sf_count_t)frame * frameSize_;
+            if (sf_seek(sndFile_, sample, SEEK_SET) < 0)
+                sf_seek(sndFile_, 0, SEEK_END);
+        }
+    }
+
     int AudioFileCutter::getFrameSize() const
     {
         return frameSize_;
@@ -89,6 +89,11 @@ namespace loudness{
          */
         int getNFrames() const;
 
+        /** Moves to the frame with index frame, so that the next call to
+         * process() returns that frame. Frames beyond the end of the audio
+         * file are zeros. */
+        void seekFrame(int frame);
+
     private:
         virtual bool initializeInternal(const SignalBank &input){return 0;};
         virtual bool initializeInternal();
@@ -50,6 +50,9 @@ namespace loudness{
         }
 
 
+        Real ratio = 1.0;
+        identicalInhibition_ = 2 / (1 + pow(1.0 / cosh(ratio), 1.5978));
+
         //output is same form as input
         output_.initialize (input);
 
@@ -58,6 +61,26 @@ namespace loudness{
 
     void BinauralInhibitionMG2007::processInternal(const SignalBank &input)
     {       
+        /* Identical ears give identical smoothed patterns, so both
+         * inhibition factors reduce to the value for a ratio of one. */
+        if (getNEarsToProcess(input) == 1)
+        {
+            for (int src = 0; src < input.getNSources(); ++src)
+            {
+                const Real* inputSpecificLoudness = input
+                                                    .getSingleSampleReadPointer
+                                                    (src, 0, 0);
+                Real* outputSpecificLoudness = output_
+                                               .getSingleSampleWritePointer
+                                               (src, 0, 0);
+                for (int chn = 0; chn < input.getNChannels(); ++chn)
+                    outputSpecificLoudness[chn] = inputSpecificLoudness[chn]
+                                                  / identicalInhibition_;
+            }
+            mirrorEars();
+            return;
+        }
+
         for (int src = 0; src < input.getNSources(); ++src)
         {
             const Real* inputSpecificLoudnessLeft = input
@@ -74,45 +97,48 @@ namespace loudness{
                                                 (src, 1, 0);
 
             int nChannels = input.getNChannels();
-            for (int chn = 0; chn < nChannels; ++chn)
-            { 
-                /* Stage 1: Smooth the specific loudness patterns */
-                Real smoothLeft = 0.0;
-                Real smoothRight = 0.0;
-
-                //Right side
-                int i = chn, j = 0;
-                while (i < nChannels)
-                {
-                    smoothLeft += inputSpecificLoudnessLeft[i] * gaussian_[j];
-                    smoothRight += inputSpecificLoudnessRight[i++] * gaussian_[j++];
-                }
-
-                //left side
-                j = nChannels - j;
-                i = 0;
-                while (j > 0)
-                {
-                    smoothLeft += inputSpecificLoudnessLeft[i] * gaussian_[j];
-                    smoothRight += inputSpecificLoudnessRight[i++] * gaussian_[j--];
+            processChannels(nChannels, 32, [&](int begin, int end)
+            {
+                for (int chn = begin; chn < end; ++chn)
+                { 
+                    /* Stage 1: Smooth the specific loudness patterns */
+                    Real smoothLeft = 0.0;
+                    Real smoothRight = 0.0;
+
+                    //Right side
+                    int i = chn, j = 0;
+                    while (i < nChannels)
+                    {
+                        smoothLeft += inputSpecificLoudnessLeft[i] * gaussian_[j];
+                        smoothRight += inputSpecificLoudnessRight[i++] * gaussian_[j++];
+                    }
+
+                    //left side
+                    j = nChannels - j;
+                    i = 0;
+                    while (j > 0)
+                    {
+                        smoothLeft += inputSpecificLoudnessLeft[i] * gaussian_[j];
+                        smoothRight += inputSpecificLoudnessRight[i++] * gaussian_[j--];
+                    }
+
+                    /* Stage 2: Inhibition using Eqs 2 and 3 */
+                    smoothLeft = max(smoothLeft, 1e-12);
+                    smoothRight = max(smoothRight, 1e-12);
+                    Real inhibLeft = 2 / (1 + pow(1.0 / cosh(smoothRight / smoothLeft), 1.5978));
+                    Real inhibRight = 2 / (1 + pow(1.0 / cosh(smoothLeft / smoothRight), 1.5978));
+
+                    /* Stage 3: Apply gains */
+                    outputSpecificLoudnessLeft[chn] = inputSpecificLoudnessLeft[chn] / inhibLeft;
+                    outputSpecificLoudnessRight[chn] = inputSpecificLoudnessRight[chn] / inhibRight;
+
+                    //to output smoothed specific loudness patterns, uncomment:
+                    /*
+                    outputSpecificLoudnessLeft[chn] = smoothLeft;
+                    outputSpecificLoudnessRight[chn] = smoothRight;
+                    */
                 }
-
-                /* Stage 2: Inhibition using Eqs 2 and 3 */
-                smoothLeft = max(smoothLeft, 1e-12);
-                smoothRight = max(smoothRight, 1e-12);
-                Real inhibLeft = 2 / (1 + pow(1.0 / cosh(smoothRight / smoothLeft), 1.5978));
-                Real inhibRight = 2 / (1 + pow(1.0 / cosh(smoothLeft / smoothRight), 1.5978));
-
-                /* Stage 3: Apply gains */
-                outputSpecificLoudnessLeft[chn] = inputSpecificLoudnessLeft[chn] / inhibLeft;
-                outputSpecificLoudnessRight[chn] = inputSpecificLoudnessRight[chn] / inhibRight;
-
-                //to output smoothed specific loudness patterns, uncomment:
-                /*
-                outputSpecificLoudnessLeft[chn] = smoothLeft;
-                outputSpecificLoudnessRight[chn] = smoothRight;
-                */
-            }
+            });
         }
     }
 
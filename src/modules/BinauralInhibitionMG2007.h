@@ -31,7 +31,9 @@ namespace loudness{
      * implements the the binaural inhibition model proposed by Moore and
      * Glasberg (2007).
      *
-     * The input SignalBank must have two ears.
+     * The input SignalBank must have two ears. If the ears are flagged as
+     * identical (see SignalBank::areEarsIdentical()), the inhibition reduces
+     * to a constant gain which is applied to the first ear and mirrored.
      *
      * This implementation is *essentially* the same as the method described in a
      * first draft of the ISO 532-2 (2014) which is subject to change. The
@@ -60,14 +62,18 @@ namespace loudness{
 
         virtual ~BinauralInhibitionMG2007();
 
+        virtual Module* clone() const {return new BinauralInhibitionMG2007(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
 
         RealVec gaussian_;
+        Real identicalInhibition_;
     };
 }
 #endif
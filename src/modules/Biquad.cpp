@@ -161,4 +161,14 @@ namespace loudness{
     {
         delayLine_.zeroSignals();
     }
+
+    void Biquad::saveStateInternal(RealVec &state) const
+    {
+        appendState(state, delayLine_);
+    }
+
+    bool Biquad::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return extractState(state, pos, delayLine_);
+    }
 }
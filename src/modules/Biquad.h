@@ -54,12 +54,16 @@ namespace loudness{
             void setCoefficientFs(const Real coefficientFs);
             virtual ~Biquad();
 
+            virtual Module* clone() const {return new Biquad(*this);};
+
         private:
             virtual bool initializeInternal(const SignalBank &input);
             virtual bool initializeInternal(){return 0;};
             virtual void processInternal(const SignalBank &input);
             virtual void processInternal(){};
             virtual void resetInternal();
+            virtual void saveStateInternal(RealVec &state) const;
+            virtual bool loadStateInternal(const RealVec &state, int &pos);
 
             std::string type_;
             Real coefficientFs_ = 0;
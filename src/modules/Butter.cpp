@@ -139,4 +139,30 @@ namespace loudness{
     {
         delayLine_.zeroSignals();
     }
+
+    void Butter::saveStateInternal(RealVec &state) const
+    {
+        appendState(state, delayLine_);
+    }
+
+    bool Butter::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return extractState(state, pos, delayLine_);
+    }
+
+    bool Butter::isEquivalentTo(const Module& other) const
+    {
+        const Butter* that = dynamic_cast<const Butter*>(&other);
+        return that &&
+               order_ == that -> order_ &&
+               type_ == that -> type_ &&
+               fc_ == that -> fc_;
+    }
+
+    void Butter::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {order_, type_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(&fc_, sizeof(fc_), hash);
+    }
 }
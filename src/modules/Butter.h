@@ -41,12 +41,18 @@ namespace loudness{
 
         virtual ~Butter();
 
+        virtual Module* clone() const {return new Butter(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
 
         int type_;
         Real fc_;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "ChannelSelector.h"
+
+namespace loudness{
+
+    ChannelSelector::ChannelSelector(int firstChannel, int nChannels) :
+        Module("ChannelSelector"),
+        firstChannel_(firstChannel),
+        nChannels_(nChannels)
+    {
+        LOUDNESS_DEBUG(name_ << ": Constructed.");
+    }
+
+    ChannelSelector::~ChannelSelector()
+    {};
+
+    bool ChannelSelector::initializeInternal(const SignalBank &input)
+    {
+        if ((firstChannel_ < 0) || (nChannels_ < 1) ||
+                (firstChannel_ + nChannels_ > input.getNChannels()))
+        {
+            LOUDNESS_ERROR(name_ << ": Channels out of range.");
+            return 0;
+        }
+
+        output_.initialize(input.getNSources(),
+                input.getNEars(),
+                nChannels_,
+                input.getNSamples(),
+                input.getFs());
+        output_.setFrameRate(input.getFrameRate());
+        for (int chn = 0; chn < nChannels_; ++chn)
+            output_.setCentreFreq(chn, input.getCentreFreq(firstChannel_ + chn));
+
+        return 1;
+    }
+
+    void ChannelSelector::processInternal(const SignalBank &input)
+    {       
+        int nSamplesToCopy = nChannels_ * input.getNSamples();
+        for (int src = 0; src < input.getNSources(); src++)
+        {
+            for (int ear = 0; ear < input.getNEars(); ++ear)
+            {
+                const Real* x = input.getSignalReadPointer(src,
+                        ear, firstChannel_, 0);
+                Real* y = output_.getSignalWritePointer(src, ear, 0, 0);
+                std::copy(x, x + nSamplesToCopy, y);
+            }
+        }
+    }
+
+    void ChannelSelector::resetInternal()
+    {}
+
+    void ChannelSelector::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {firstChannel_, nChannels_};
+        hashBytes(config, sizeof(config), hash);
+    }
+}
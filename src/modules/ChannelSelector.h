@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef CHANNELSELECTOR_H
+#define CHANNELSELECTOR_H
+
+#include "../support/Module.h"
+
+namespace loudness{
+
+    /**
+     * @class ChannelSelector
+     *
+     * @brief Copies a contiguous block of channels of the input SignalBank to
+     * the output SignalBank.
+     *
+     * This is used to give each block of a multi-channel output, such as that
+     * of an ARAveragerBank, its own output name in a Model.
+     */
+    class ChannelSelector : public Module
+    {
+    public:
+ 
+        /** Selects nChannels channels starting at firstChannel. */
+        ChannelSelector(int firstChannel, int nChannels);
+
+        virtual ~ChannelSelector();
+
+        virtual Module* clone() const {return new ChannelSelector(*this);};
+
+        virtual bool isStateless() const {return true;};
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
+
+        int firstChannel_, nChannels_;
+    };
+}
+
+#endif
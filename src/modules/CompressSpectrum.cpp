@@ -176,9 +176,19 @@ namespace loudness{
 
     void CompressSpectrum::processInternal(const SignalBank &input)
     {
+        //output channels summing the changed input channels
+        int changedBegin = input.getChangedChannelsBegin();
+        int changedEnd = input.getChangedChannelsEnd();
+        int begin = 0, end = output_.getNChannels();
+        while ((begin < end) && (upperBandIdx_[begin] <= changedBegin))
+            ++begin;
+        while ((end > begin + 1) && (upperBandIdx_[end - 2] >= changedEnd))
+            --end;
+
+        int nEars = getNEarsToProcess(input);
         for (int src = 0; src < input.getNSources(); ++src)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
+            for (int ear = 0; ear < nEars; ++ear)
             {
                 const Real* inputSpectrum = input.getSingleSampleReadPointer
                                                   (src, ear, 0);
@@ -186,8 +196,8 @@ namespace loudness{
                                                (src, ear, 0);
 
                 Real sum = 0.0;
-                int i = 0, j = 0;
-                while (i < output_.getNChannels()) 
+                int i = begin, j = begin > 0 ? upperBandIdx_[begin - 1] : 0;
+                while (i < end)
                 {
                     if (j < upperBandIdx_[i])
                     {
@@ -201,8 +211,21 @@ namespace loudness{
                 }
             }
         }
+
+        output_.setChangedChannels(begin, end);
+        mirrorEars();
     }
 
     void CompressSpectrum::resetInternal(){};
-}
 
+    bool CompressSpectrum::isEquivalentTo(const Module& other) const
+    {
+        const CompressSpectrum* that = dynamic_cast<const CompressSpectrum*>(&other);
+        return that && alpha_ == that -> alpha_;
+    }
+
+    void CompressSpectrum::hashConfiguration(unsigned long long& hash) const
+    {
+        hashBytes(&alpha_, sizeof(alpha_), hash);
+    }
+}
@@ -57,12 +57,17 @@ namespace loudness{
 
         virtual ~CompressSpectrum();
 
+        virtual Module* clone() const {return new CompressSpectrum(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         vector<int> upperBandIdx_;
         Real alpha_;
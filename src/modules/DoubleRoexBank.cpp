@@ -64,8 +64,10 @@ namespace loudness{
             //centre freqs in cams
             cams_.assign (nFilters_, 0.0);
 
-            //required for log interpolation
-            logExcitation_.assign (nFilters_, 0.0);
+            //required for log interpolation (per slice)
+            int nSlices = getNSlices (input.getNSources(), input.getNEars());
+            logExcitation_.assign (nSlices, RealVec (nFilters_, 0.0));
+            splines_.resize (nSlices);
 
             //388 filters to cover [1.5, 40.2] see p. 3
             output_.initialize (input.getNSources(),
@@ -91,8 +93,7 @@ namespace loudness{
         output_.setFrameRate (input.getFrameRate());
 
         //filter variables
-        wPassive_.resize (nFilters_);
-        wActive_.resize (nFilters_);
+        RealVecVec wPassive (nFilters_), wActive (nFilters_);
         maxGdB_.resize (nFilters_);
         thirdGainTerm_.resize (nFilters_);
 
@@ -144,14 +145,16 @@ namespace loudness{
                     }
 
                     //Eq. 4 and Eq. 7
-                    wPassive_[i].push_back ((1 + pgPassive) * exp (-pgPassive)); 
-                    wActive_[i].push_back ((1 + pgActive) * exp (-pgActive)); 
+                    wPassive[i].push_back ((1 + pgPassive) * exp (-pgPassive)); 
+                    wActive[i].push_back ((1 + pgActive) * exp (-pgActive)); 
                 }
                 else
                     break;
                 j++;
             }
         }
+        wPassive_ = TableRegistry::share (wPassive);
+        wActive_ = TableRegistry::share (wActive);
         LOUDNESS_DEBUG(name_ << ": Passive and active filters configured.");
         LOUDNESS_DEBUG(name_ << ": Excitation pattern will be scaled by: " 
                 << scalingFactor_);
@@ -162,28 +165,34 @@ namespace loudness{
 
     void DoubleRoexBank::processInternal(const SignalBank &input)
     {
+        const RealVecVec& wPassive = *wPassive_;
+        const RealVecVec& wActive = *wActive_;
+
         /*
          * Perform the excitation transformation
          */
-        for (int src = 0; src < input.getNSources(); ++src)
+        processSlices(input.getNSources(), input.getNEars(),
+                [&](int src, int ear, int bufferIdx)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
-            {
-                const Real* inputSpectrum = input
-                                            .getSingleSampleReadPointer
+            RealVec& logExcitation = logExcitation_[bufferIdx];
+
+            const Real* inputSpectrum = input
+                                        .getSingleSampleReadPointer
+                                        (src, ear, 0);
+            Real* outputExcitationPattern = output_
+                                            .getSingleSampleWritePointer
                                             (src, ear, 0);
-                Real* outputExcitationPattern = output_
-                                                .getSingleSampleWritePointer
-                                                (src, ear, 0);
 
-                for (int i = 0; i < nFilters_; ++i)
+            processChannels(nFilters_, 16, [&](int begin, int end)
+            {
+                for (int i = begin; i < end; ++i)
                 {
                     Real excitationLinP = 0.0;
                     Real excitationLinA = 0.0;
 
                     //passive filter output
-                    for (uint j = 0; j < wPassive_[i].size(); ++j)
-                        excitationLinP += wPassive_[i][j] * inputSpectrum[j];
+                    for (uint j = 0; j < wPassive[i].size(); ++j)
+                        excitationLinP += wPassive[i][j] * inputSpectrum[j];
 
                     //convert to dB
                     Real excitationLog = powerToDecibels (excitationLinP);
@@ -205,32 +214,46 @@ namespace loudness{
                     gain = decibelsToPower(gain);
 
                     //active filter output
-                    for (uint j = 0; j < wActive_[i].size(); ++j)
-                        excitationLinA += wActive_[i][j] * inputSpectrum[j];
+                    for (uint j = 0; j < wActive[i].size(); ++j)
+                        excitationLinA += wActive[i][j] * inputSpectrum[j];
                     excitationLinA *= gain;
 
                     //excitation pattern
                     Real excitation = scalingFactor_ * (excitationLinP + excitationLinA);
 
                     if (isExcitationPatternInterpolated_)
-                        logExcitation_[i] = log(excitation + 1e-10);
+                        logExcitation[i] = log(excitation + 1e-10);
                     else
                         outputExcitationPattern[i] = excitation;
                 }
+            });
 
-                //Interpolate to estimate 0.1~Cam res excitation pattern
-                if (isExcitationPatternInterpolated_)
-                {
-                    spline_.set_points (cams_,
-                                        logExcitation_,
-                                        isInterpolationCubic_);
+            //Interpolate to estimate 0.1~Cam res excitation pattern
+            if (isExcitationPatternInterpolated_)
+            {
+                spline& excitationSpline = splines_[bufferIdx];
+                excitationSpline.set_points (cams_,
+                                             logExcitation,
+                                             isInterpolationCubic_);
 
-                    for (int i = 0; i < 388; ++i)
-                        outputExcitationPattern[i] = exp (spline_ (camLo_ + i * 0.1));
-                }
+                processChannels(388, 64, [&](int begin, int end)
+                {
+                    for (int i = begin; i < end; ++i)
+                        outputExcitationPattern[i] = exp (excitationSpline (camLo_ + i * 0.1));
+                });
             }
-        }
+        });
     }
 
     void DoubleRoexBank::resetInternal(){};
+
+    void DoubleRoexBank::hashConfiguration(unsigned long long& hash) const
+    {
+        Real config[] = {camLo_, camHi_, camStep_, scalingFactor_};
+        //the interpolation may be turned off on initialisation
+        int interpolation[] = {isExcitationPatternInterpolated_,
+            isExcitationPatternInterpolated_ && isInterpolationCubic_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(interpolation, sizeof(interpolation), hash);
+    }
 }
@@ -21,6 +21,7 @@
 #define DOUBLEROEXBANK_H
 
 #include "../support/Module.h"
+#include "../support/TableRegistry.h"
 #include "../thirdParty/spline/Spline.h"
 
 namespace loudness{
@@ -78,6 +79,8 @@ namespace loudness{
 
         virtual ~DoubleRoexBank();
 
+        virtual Module* clone() const {return new DoubleRoexBank(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -85,13 +88,16 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         Real camLo_, camHi_, camStep_, scalingFactor_;
         bool isExcitationPatternInterpolated_, isInterpolationCubic_;
         int nFilters_;
-        RealVec maxGdB_, thirdGainTerm_, cams_, logExcitation_;
-        RealVecVec wPassive_, wActive_;
-        spline spline_;
+        RealVec maxGdB_, thirdGainTerm_, cams_;
+        RealVecVec logExcitation_;
+        std::shared_ptr<const RealVecVec> wPassive_, wActive_;
+        vector<spline> splines_;
     };
 }
 
@@ -34,6 +34,8 @@ namespace loudness{
 
         virtual ~EMA();
 
+        virtual Module* clone() const {return new EMA(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
@@ -91,4 +91,20 @@ namespace loudness{
     {
         delayLine_.zeroSignals();
     }
+
+    void FIR::saveStateInternal(RealVec &state) const
+    {
+        appendState(state, delayLine_);
+    }
+
+    bool FIR::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return extractState(state, pos, delayLine_);
+    }
+
+    void FIR::hashConfiguration(unsigned long long& hash) const
+    {
+        hashBytes(&gain_, sizeof(gain_), hash);
+        hashBytes(bCoefs_.data(), bCoefs_.size() * sizeof(Real), hash);
+    }
 }
@@ -45,12 +45,17 @@ namespace loudness{
 
         virtual ~FIR();
 
+        virtual Module* clone() const {return new FIR(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
     };
 }
 
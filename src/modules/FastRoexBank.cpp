@@ -101,13 +101,14 @@ namespace loudness{
         const Real p51_1k = 4000.0 / centreFreqToCambridgeERB (1000.0);
 
         //p upper is level invariant
-        pu_.assign (nFilters_, 0.0);
+        RealVec pu (nFilters_, 0.0);
         
         //p lower is level dependent
-        pl_.assign (nFilters_, 0.0);
+        RealVec pl (nFilters_, 0.0);
 
-        //comp_level holds level per ERB on each component
-        compLevel_.assign (input.getNChannels(), 0.0);
+        //comp_level holds level per ERB on each component (per slice)
+        int nSlices = getNSlices (input.getNSources(), input.getNEars());
+        compLevel_.assign (nSlices, RealVec (input.getNChannels(), 0.0));
 
         //centre freqs in Hz
         fc_.assign (nFilters_, 0.0);
@@ -119,7 +120,8 @@ namespace loudness{
             cams_.assign (nFilters_, 0.0);
 
             //required for log interpolation
-            excitationLevel_.assign (nFilters_, 0.0);
+            excitationLevel_.assign (nSlices, RealVec (nFilters_, 0.0));
+            splines_.resize (nSlices);
 
             //372 filters over [1.8, 38.9] in 0.1 steps
             output_.initialize (input.getNSources(),
@@ -159,10 +161,12 @@ namespace loudness{
             //get the ERB of the filter
             Real erb = centreFreqToCambridgeERB (fc_[i]);
             //ANSI S3.4 sec 3.5 p.11
-            pu_[i] = 4.0 * fc_[i] / erb;
+            pu[i] = 4.0 * fc_[i] / erb;
             //from Eq (3)
-            pl_[i] = 0.35 * (pu_[i] / p51_1k);
+            pl[i] = 0.35 * (pu[i] / p51_1k);
         }
+        pu_ = TableRegistry::share (pu);
+        pl_ = TableRegistry::share (pl);
         
         //generate lookup table for rounded exponential
         generateRoexTable(1024);
@@ -172,97 +176,103 @@ namespace loudness{
 
     void FastRoexBank::processInternal(const SignalBank &input)
     {
-        for (int src = 0; src < input.getNSources(); ++src)
+        const RealVec& pu = *pu_;
+        const RealVec& pl = *pl_;
+        const RealVec& roexTable = *roexTable_;
+
+        processSlices(input.getNSources(), input.getNEars(),
+                [&](int src, int ear, int bufferIdx)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
+            RealVec& compLevel = compLevel_[bufferIdx];
+            RealVec& excitationLevel = excitationLevel_[bufferIdx];
+
+            /*
+             * Part 1: Obtain the level per ERB about each input component
+             */
+            int nChannels = input.getNChannels();
+            const Real* inputPowerSpectrum = input
+                                             .getSingleSampleReadPointer
+                                             (src, ear, 0);
+            Real* outputExcitationPattern = output_
+                                            .getSingleSampleWritePointer
+                                            (src, ear, 0);
+
+            Real runningSum = 0.0;
+            int j = 0;
+            int k = rectBinIndices_[0][0];
+            for (int i = 0; i < nChannels; ++i)
             {
-                /*
-                 * Part 1: Obtain the level per ERB about each input component
-                 */
-                int nChannels = input.getNChannels();
-                const Real* inputPowerSpectrum = input
-                                                 .getSingleSampleReadPointer
-                                                 (src, ear, 0);
-                Real* outputExcitationPattern = output_
-                                                .getSingleSampleWritePointer
-                                                (src, ear, 0);
-
-                Real runningSum = 0.0;
-                int j = 0;
-                int k = rectBinIndices_[0][0];
-                for (int i = 0; i < nChannels; ++i)
-                {
-                    //running sum of component powers
-                    while (j < rectBinIndices_[i][1])
-                        runningSum += inputPowerSpectrum[j++];
+                //running sum of component powers
+                while (j < rectBinIndices_[i][1])
+                    runningSum += inputPowerSpectrum[j++];
 
-                    //subtract components outside the window
-                    while (k < rectBinIndices_[i][0])
-                        runningSum -= inputPowerSpectrum[k++];
+                //subtract components outside the window
+                while (k < rectBinIndices_[i][0])
+                    runningSum -= inputPowerSpectrum[k++];
 
-                    //convert to dB, subtract 51 here to save operations later
-                    compLevel_[i] = powerToDecibels (runningSum, 1e-10, -100.0) - 51;
-                }
+                //convert to dB, subtract 51 here to save operations later
+                compLevel[i] = powerToDecibels (runningSum, 1e-10, -100.0) - 51;
+            }
+
+            /*
+             * Part 2: Complete roex filter response and compute excitation per ERB
+             */
+            Real g = 0.0, p = 0.0, pg = 0.0, excitationLin = 0.0;
+            int idx = 0;
+            for (int i = 0; i < nFilters_; ++i)
+            {
+                excitationLin = 0.0;
+                j = 0;
 
-                /*
-                 * Part 2: Complete roex filter response and compute excitation per ERB
-                 */
-                Real g = 0.0, p = 0.0, pg = 0.0, excitationLin = 0.0;
-                int idx = 0;
-                for (int i = 0; i < nFilters_; ++i)
+                while (j < nChannels)
                 {
-                    excitationLin = 0.0;
-                    j = 0;
+                    //normalised deviation
+                    g = (input.getCentreFreq(j) - fc_[i]) / fc_[i];
 
-                    while (j < nChannels)
+                    if (g > 2)
+                        break;
+                    if (g < 0) //lower skirt - level dependent
                     {
-                        //normalised deviation
-                        g = (input.getCentreFreq(j) - fc_[i]) / fc_[i];
-
-                        if (g > 2)
-                            break;
-                        if (g < 0) //lower skirt - level dependent
-                        {
-                            //Complete Eq (3)
-                            p = pu_[i] - (pl_[i] * compLevel_[j]); //51dB subtracted above
-                            p = max(p, 0.1); //p can go negative for very high levels
-                            pg = -p * g; //p * abs (g)
-                        }
-                        else //upper skirt
-                        {
-                            pg = pu_[i] * g; //p * abs(g)
-                        }
-                        
-                        //excitation
-                        idx = (int)(pg / step_ + 0.5);
-                        idx = min (idx, roexIdxLimit_);
-                        excitationLin += roexTable_[idx] * inputPowerSpectrum[j++]; 
+                        //Complete Eq (3)
+                        p = pu[i] - (pl[i] * compLevel[j]); //51dB subtracted above
+                        p = max(p, 0.1); //p can go negative for very high levels
+                        pg = -p * g; //p * abs (g)
                     }
-
-                    //excitation level
-                    if (isExcitationPatternInterpolated_)
-                        excitationLevel_[i] = log (excitationLin + 1e-10);
-                    else
-                        outputExcitationPattern[i] = excitationLin;
+                    else //upper skirt
+                    {
+                        pg = pu[i] * g; //p * abs(g)
+                    }
+                
+                    //excitation
+                    idx = (int)(pg / step_ + 0.5);
+                    idx = min (idx, roexIdxLimit_);
+                    excitationLin += roexTable[idx] * inputPowerSpectrum[j++]; 
                 }
 
-                /*
-                 * Part 3: Interpolate to estimate 
-                 * 0.1~Cam res excitation pattern
-                 */
+                //excitation level
                 if (isExcitationPatternInterpolated_)
+                    excitationLevel[i] = log (excitationLin + 1e-10);
+                else
+                    outputExcitationPattern[i] = excitationLin;
+            }
+
+            /*
+             * Part 3: Interpolate to estimate 
+             * 0.1~Cam res excitation pattern
+             */
+            if (isExcitationPatternInterpolated_)
+            {
+                spline& excitationSpline = splines_[bufferIdx];
+                excitationSpline.set_points (cams_,
+                        excitationLevel,
+                        isInterpolationCubic_);
+                for (int i = 0; i < 372; ++i)
                 {
-                    spline_.set_points (cams_,
-                            excitationLevel_,
-                            isInterpolationCubic_);
-                    for (int i = 0; i < 372; ++i)
-                    {
-                        excitationLin = exp (spline_ (1.8 + i * 0.1));
-                        outputExcitationPattern[i] = excitationLin;
-                    }
+                    excitationLin = exp (excitationSpline (1.8 + i * 0.1));
+                    outputExcitationPattern[i] = excitationLin;
                 }
             }
-        }
+        });
     }
 
     void FastRoexBank::resetInternal(){};
@@ -271,7 +281,7 @@ namespace loudness{
     {
         size = max (size, 512);
         roexIdxLimit_ = size - 1;
-        roexTable_.resize (size);
+        RealVec roexTable (size);
 
         double pgLim = 20.48; //end value is 20.46
         double pg;
@@ -280,8 +290,18 @@ namespace loudness{
         for (int i = 0; i < size; ++i)
         {
             pg = step_ * i;
-            roexTable_[i] = (1 + pg) * exp (-pg);
+            roexTable[i] = (1 + pg) * exp (-pg);
         }
+        roexTable_ = TableRegistry::share (roexTable);
+    }
+
+    void FastRoexBank::hashConfiguration(unsigned long long& hash) const
+    {
+        //the interpolation may be turned off on initialisation
+        int config[] = {isExcitationPatternInterpolated_,
+            isExcitationPatternInterpolated_ && isInterpolationCubic_};
+        hashBytes(&camStep_, sizeof(camStep_), hash);
+        hashBytes(config, sizeof(config), hash);
     }
 }
 
@@ -21,6 +21,7 @@
 #define FASTROEXBANK_H
 
 #include "../support/Module.h"
+#include "../support/TableRegistry.h"
 #include "../thirdParty/spline/Spline.h"
 
 namespace loudness{
@@ -70,6 +71,8 @@ namespace loudness{
 
         virtual ~FastRoexBank();
 
+        virtual Module* clone() const {return new FastRoexBank(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -77,6 +80,8 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         void generateRoexTable(int size = 1024);
 
@@ -85,8 +90,10 @@ namespace loudness{
         int nFilters_, roexIdxLimit_;
         Real step_;
         vector<vector<int> > rectBinIndices_;
-        RealVec cams_, pu_, pl_, fc_, compLevel_, roexTable_, excitationLevel_;
-        spline spline_;
+        RealVec cams_, fc_;
+        std::shared_ptr<const RealVec> pu_, pl_, roexTable_;
+        RealVecVec compLevel_, excitationLevel_;
+        vector<spline> splines_;
     };
 }
 
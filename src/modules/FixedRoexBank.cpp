@@ -129,5 +129,11 @@ namespace loudness{
     }
 
     void FixedRoexBank::resetInternal(){};
+
+    void FixedRoexBank::hashConfiguration(unsigned long long& hash) const
+    {
+        Real config[] = {camLo_, camHi_, camStep_, level_};
+        hashBytes(config, sizeof(config), hash);
+    }
 }
 
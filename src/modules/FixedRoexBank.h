@@ -35,12 +35,15 @@ namespace loudness{
 
         virtual ~FixedRoexBank();
 
+        virtual Module* clone() const {return new FixedRoexBank(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         Real camLo_, camHi_, camStep_, level_;
         RealVecVec roex_;
@@ -34,6 +34,8 @@ namespace loudness{
 
             virtual ~ForwardMaskingPO1998();
 
+            virtual Module* clone() const {return new ForwardMaskingPO1998(*this);};
+
         private:
             virtual bool initializeInternal(const SignalBank &input);
             virtual bool initializeInternal(){return 0;};
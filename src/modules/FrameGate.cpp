@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "FrameGate.h"
+
+namespace loudness{
+
+    FrameGate::FrameGate(Real silenceThresholdInDB, Real tolerance) :
+        Module("FrameGate"),
+        silenceThreshold_(pow(10.0, silenceThresholdInDB / 10.0)),
+        tolerance_(tolerance),
+        floor_(0.0),
+        reference_(NONE),
+        nFrames_(0),
+        nSilentFrames_(0),
+        nSteadyFrames_(0)
+    {
+        LOUDNESS_DEBUG(name_ << ": Constructed.");
+    }
+
+    FrameGate::~FrameGate()
+    {};
+
+    long long FrameGate::getNFrames() const
+    {
+        return nFrames_;
+    }
+
+    long long FrameGate::getNSilentFrames() const
+    {
+        return nSilentFrames_;
+    }
+
+    long long FrameGate::getNSteadyFrames() const
+    {
+        return nSteadyFrames_;
+    }
+
+    void FrameGate::resetCounters()
+    {
+        nFrames_ = 0;
+        nSilentFrames_ = 0;
+        nSteadyFrames_ = 0;
+    }
+
+    bool FrameGate::initializeInternal(const SignalBank &input)
+    {
+        LOUDNESS_DEBUG(name_ << ": Silence threshold (power): "
+                << silenceThreshold_
+                << ". Relative tolerance: "
+                << tolerance_);
+        //a silent frame spread over the components of one ear
+        floor_ = silenceThreshold_ / input.getNTotalSamplesPerEar();
+
+        output_.initialize(input);
+        reference_ = NONE;
+        return 1;
+    }
+
+    bool FrameGate::isSteady(const SignalBank &input) const
+    {
+        if ((reference_ != SPECTRUM) || (tolerance_ <= 0))
+            return false;
+
+        const Real* x = input.getSignalReadPointer(0, 0, 0);
+        const Real* ref = output_.getSignalReadPointer(0, 0, 0);
+        for (int i = 0; i < input.getNTotalSamples(); ++i)
+        {
+            if (fabs(x[i] - ref[i]) > tolerance_ * ref[i] + floor_)
+                return false;
+        }
+        return true;
+    }
+
+    void FrameGate::processInternal(const SignalBank &input)
+    {
+        ++nFrames_;
+
+        Real power = 0.0;
+        const Real* x = input.getSignalReadPointer(0, 0, 0);
+        for (int i = 0; i < input.getNTotalSamples(); ++i)
+            power += x[i];
+
+        if (power < silenceThreshold_)
+        {
+            if (reference_ == SILENCE)
+            {
+                ++nSilentFrames_;
+                output_.setUnchanged(true);
+            }
+            else
+            {
+                output_.zeroSignals();
+                output_.setEarsIdentical(true);
+                reference_ = SILENCE;
+            }
+        }
+        else if (isSteady(input))
+        {
+            ++nSteadyFrames_;
+            output_.setUnchanged(true);
+        }
+        else
+        {
+            output_.copySamples(input);
+            output_.setEarsIdentical(input.areEarsIdentical());
+            reference_ = SPECTRUM;
+        }
+    }
+
+    void FrameGate::resetInternal()
+    {
+        reference_ = NONE;
+    }
+
+    void FrameGate::saveStateInternal(RealVec &state) const
+    {
+        state.push_back(reference_);
+    }
+
+    bool FrameGate::loadStateInternal(const RealVec &state, int &pos)
+    {
+        Real reference = NONE;
+        if (!extractState(state, pos, reference))
+            return 0;
+        reference_ = (Reference)(int)reference;
+        return 1;
+    }
+
+    void FrameGate::hashConfiguration(unsigned long long& hash) const
+    {
+        Real config[] = {silenceThreshold_, tolerance_};
+        hashBytes(config, sizeof(config), hash);
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef FRAMEGATE_H
+#define FRAMEGATE_H
+
+#include "../support/Module.h"
+
+namespace loudness{
+
+    /**
+     * @class FrameGate
+     *
+     * @brief Passes on a power spectrum but flags silent and steady frames as
+     * unchanged so that the stateless modules which follow skip them.
+     *
+     * The output holds the last spectrum passed on in full, the reference.
+     * Each triggered frame is classified as:
+     *
+     * 1. Silent: the total power of all sources and ears is below the silence
+     *    threshold. The first silent frame of a run passes on an all-zero
+     *    spectrum, so the targets compute the silence pattern once. Later
+     *    silent frames are flagged unchanged and reuse it.
+     * 2. Steady: every component is within a relative tolerance of the
+     *    reference, i.e. |x - ref| <= tolerance * ref + floor, where floor is
+     *    the silence threshold divided by the number of components per ear.
+     *    The frame is flagged unchanged and the targets reuse their previous
+     *    output.
+     * 3. Active: the spectrum becomes the new reference and is passed on.
+     *
+     * Because the reference is only replaced by active frames, the deviation
+     * does not accumulate over a steady passage: each component of the
+     * spectrum seen by the targets is within a factor (1 +/- tolerance) of the
+     * true one, give or take a total power below the silence threshold. For
+     * excitation patterns computed with fixed filter shapes the same bound
+     * holds for each excitation channel. Specific loudness grows more slowly
+     * than excitation except close to threshold, where its relative deviation
+     * can be a few times the tolerance; loudness integrated over channels is
+     * affected much less. Silent frames are treated as if there were no
+     * input.
+     *
+     * A threshold of -inf dB or a tolerance of zero disables the respective
+     * test. Input power is assumed to be in the units used by the models,
+     * i.e. 1 corresponds to 0 dB SPL.
+     */
+    class FrameGate : public Module
+    {
+    public:
+ 
+        /** Constructs a FrameGate.
+         *
+         * @param silenceThresholdInDB Total power below which a frame is
+         * silent.
+         * @param tolerance Relative tolerance below which a frame is steady.
+         */
+        FrameGate(Real silenceThresholdInDB = -20.0, Real tolerance = 0.01);
+
+        virtual ~FrameGate();
+
+        virtual Module* clone() const {return new FrameGate(*this);};
+
+        /** Returns the number of triggered frames processed. */
+        long long getNFrames() const;
+
+        /** Returns the number of silent frames flagged as unchanged. */
+        long long getNSilentFrames() const;
+
+        /** Returns the number of steady frames flagged as unchanged. */
+        long long getNSteadyFrames() const;
+
+        /** Sets all frame counters to zero. */
+        void resetCounters();
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
+        virtual void hashConfiguration(unsigned long long& hash) const;
+
+        bool isSteady(const SignalBank &input) const;
+
+        enum Reference {NONE, SILENCE, SPECTRUM};
+
+        Real silenceThreshold_, tolerance_, floor_;
+        Reference reference_;
+        long long nFrames_, nSilentFrames_, nSteadyFrames_;
+    };
+}
+
+#endif
@@ -138,6 +138,25 @@ namespace loudness{
         output_.setTrig(false);
     }
 
+    void FrameGenerator::saveStateInternal(RealVec &state) const
+    {
+        state.push_back(writeIdx_);
+        state.push_back(remainingSamples_);
+        appendState(state, audioBufferBank_);
+    }
+
+    bool FrameGenerator::loadStateInternal(const RealVec &state, int &pos)
+    {
+        Real writeIdx = 0, remainingSamples = 0;
+        if (!extractState(state, pos, writeIdx) ||
+                !extractState(state, pos, remainingSamples) ||
+                !extractState(state, pos, audioBufferBank_))
+            return 0;
+        writeIdx_ = (int)writeIdx;
+        remainingSamples_ = (int)remainingSamples;
+        return 1;
+    }
+
     int FrameGenerator::getFrameSize() const
     {
         return frameSize_;
@@ -153,4 +172,18 @@ namespace loudness{
         return startAtCentreOfFrame_;
     }
 
+    bool FrameGenerator::isEquivalentTo(const Module& other) const
+    {
+        const FrameGenerator* that = dynamic_cast<const FrameGenerator*>(&other);
+        return that &&
+               frameSize_ == that -> frameSize_ &&
+               hopSize_ == that -> hopSize_ &&
+               startAtCentreOfFrame_ == that -> startAtCentreOfFrame_;
+    }
+
+    void FrameGenerator::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {frameSize_, hopSize_, startAtCentreOfFrame_};
+        hashBytes(config, sizeof(config), hash);
+    }
 }
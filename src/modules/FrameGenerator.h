@@ -55,6 +55,8 @@ namespace loudness{
         FrameGenerator(int frameSize = 1024, int hopSize = 512, bool startAtFrameCentre = false);
         virtual ~FrameGenerator();
 
+        virtual Module* clone() const {return new FrameGenerator(*this);};
+
         /**
          * @brief Returns the total number of samples comprising the frame.
          */
@@ -77,6 +79,10 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
 
         int frameSize_, hopSize_, audioBufferSize_, inputBufferSize_;
         int writeIdx_, overlap_, remainingSamples_;
@@ -298,6 +298,46 @@ namespace loudness{
         configureDelayLineIndices();
     }
 
+    void HoppingGoertzelDFT::saveStateInternal(RealVec &state) const
+    {
+        state.push_back(writeIdx_);
+        state.push_back(nSamplesUntilTrigger_);
+        for (int w = 0; w < nWindows_; ++w)
+        {
+            state.push_back(readIdx_[w][0]);
+            state.push_back(readIdx_[w][1]);
+        }
+        appendState(state, delayLine_);
+        appendState(state, vPrev_);
+        appendState(state, vPrev2_);
+    }
+
+    bool HoppingGoertzelDFT::loadStateInternal(const RealVec &state, int &pos)
+    {
+        Real writeIdx = 0, nSamplesUntilTrigger = 0;
+        if (!extractState(state, pos, writeIdx) ||
+                !extractState(state, pos, nSamplesUntilTrigger))
+            return 0;
+        vector< vector<int>> readIdx(readIdx_);
+        for (int w = 0; w < nWindows_; ++w)
+        {
+            Real idx1 = 0, idx2 = 0;
+            if (!extractState(state, pos, idx1) ||
+                    !extractState(state, pos, idx2))
+                return 0;
+            readIdx[w][0] = (int)idx1;
+            readIdx[w][1] = (int)idx2;
+        }
+        if (!extractState(state, pos, delayLine_) ||
+                !extractState(state, pos, vPrev_) ||
+                !extractState(state, pos, vPrev2_))
+            return 0;
+        writeIdx_ = (int)writeIdx;
+        nSamplesUntilTrigger_ = (int)nSamplesUntilTrigger;
+        readIdx_ = readIdx;
+        return 1;
+    }
+
     void HoppingGoertzelDFT::configureDelayLineIndices()
     {
         writeIdx_ = 0;
@@ -447,5 +487,17 @@ namespace loudness{
     {
         isFirstSampleAtWindowCentre_ = isFirstSampleAtWindowCentre;
     }
-}
 
+    void HoppingGoertzelDFT::hashConfiguration(unsigned long long& hash)
+        const
+    {
+        int config[] = {hopSize_, isHannWindowUsed_, isPowerSpectrum_,
+            isFirstSampleAtWindowCentre_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(&referenceValue_, sizeof(referenceValue_), hash);
+        hashBytes(frequencyBandEdges_.data(),
+                frequencyBandEdges_.size() * sizeof(Real), hash);
+        hashBytes(windowSizes_.data(), windowSizes_.size() * sizeof(int),
+                hash);
+    }
+}
@@ -80,6 +80,8 @@ namespace loudness{
                 bool isHannWindowUsed,
                 bool isPowerSpectrum);
         virtual ~HoppingGoertzelDFT();
+
+        virtual Module* clone() const {return new HoppingGoertzelDFT(*this);};
         void setReferenceValue (Real referenceValue);
         void setFirstSampleAtWindowCentre (bool isFirstSampleAtWindowCentre);
 
@@ -89,6 +91,9 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
         void configureDelayLineIndices();
         void calculateSpectrum();
         void calculatePowerSpectrum();
@@ -120,4 +120,21 @@ namespace loudness{
     {
         delayLine_.zeroSignals();
     }
+
+    void IIR::saveStateInternal(RealVec &state) const
+    {
+        appendState(state, delayLine_);
+    }
+
+    bool IIR::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return extractState(state, pos, delayLine_);
+    }
+
+    void IIR::hashConfiguration(unsigned long long& hash) const
+    {
+        hashBytes(&gain_, sizeof(gain_), hash);
+        hashBytes(bCoefs_.data(), bCoefs_.size() * sizeof(Real), hash);
+        hashBytes(aCoefs_.data(), aCoefs_.size() * sizeof(Real), hash);
+    }
 }
@@ -114,4 +114,11 @@ namespace loudness{
     void InstantaneousLoudness::resetInternal()
     {
     }
+
+    void InstantaneousLoudness::hashConfiguration(unsigned long long& hash) const
+    {
+        int diotic = dioticPresentation_;
+        hashBytes(&cParam_, sizeof(cParam_), hash);
+        hashBytes(&diotic, sizeof(diotic), hash);
+    }
 }
@@ -53,12 +53,16 @@ namespace loudness{
 
         virtual ~InstantaneousLoudness();
 
+        virtual Module* clone() const {return new InstantaneousLoudness(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         Real cParam_;
         bool dioticPresentation_;
@@ -201,4 +201,10 @@ namespace loudness{
     }
 
    void InstantaneousLoudnessDIN456311991::resetInternal(){};
+
+    void InstantaneousLoudnessDIN456311991::hashConfiguration(unsigned long long& hash) const
+    {
+        int config = isOutputRounded_;
+        hashBytes(&config, sizeof(config), hash);
+    }
 }
@@ -62,6 +62,8 @@ namespace loudness{
         InstantaneousLoudnessDIN456311991 (bool isOutputRounded = false);
         virtual ~InstantaneousLoudnessDIN456311991();
 
+        virtual Module* clone() const {return new InstantaneousLoudnessDIN456311991(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -69,6 +71,7 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
         
         bool isOutputRounded_;
         RealVec zUP_, rNS_;
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "LoudnessDescriptors.h"
+
+namespace loudness{
+
+    LoudnessDescriptors::LoudnessDescriptors(Real lowerLimitInDecibels,
+            Real upperLimitInDecibels,
+            Real binWidthInDecibels) :
+        Module("LoudnessDescriptors"),
+        lowerLimitInDecibels_(lowerLimitInDecibels),
+        upperLimitInDecibels_(upperLimitInDecibels),
+        binWidthInDecibels_(binWidthInDecibels)
+    {
+        LOUDNESS_DEBUG(name_ << ": Constructed.");
+    }
+
+    LoudnessDescriptors::~LoudnessDescriptors()
+    {}
+
+    bool LoudnessDescriptors::initializeInternal(const SignalBank &input)
+    {
+        if ((upperLimitInDecibels_ <= lowerLimitInDecibels_) ||
+            (binWidthInDecibels_ <= 0))
+        {
+            LOUDNESS_ERROR(name_ << ": Invalid histogram specification.");
+            return 0;
+        }
+
+        nBins_ = (int)ceil((upperLimitInDecibels_ - lowerLimitInDecibels_) /
+                binWidthInDecibels_);
+        nEars_ = input.getNEars();
+        nChannels_ = input.getNChannels();
+        int nSignals = input.getNSources() * nEars_ * nChannels_;
+
+        LOUDNESS_DEBUG(name_ << ": Number of histogram bins per signal: "
+                << nBins_);
+
+        sum_.assign (nSignals, 0.0);
+        count_.assign (nSignals, 0);
+        histogram_.assign (nSignals * nBins_, 0);
+
+        //one sample per descriptor
+        output_.initialize (input.getNSources(),
+                            nEars_,
+                            nChannels_,
+                            N_DESCRIPTORS,
+                            input.getFs());
+        output_.setCentreFreqs (input.getCentreFreqs());
+        output_.setChannelSpacingInCams (input.getChannelSpacingInCams());
+        output_.setFrameRate (input.getFrameRate());
+
+        return 1;
+    }
+
+    void LoudnessDescriptors::processInternal(const SignalBank &input)
+    {
+        int signalIdx = 0;
+        for (int src = 0; src < input.getNSources(); ++src)
+        {
+            for (int ear = 0; ear < input.getNEars(); ++ear)
+            {
+                for (int chn = 0; chn < input.getNChannels(); ++chn)
+                {
+                    const Real* x = input.getSignalReadPointer(src, ear, chn, 0);
+                    Real* y = output_.getSignalWritePointer(src, ear, chn, 0);
+                    long long* hist = &histogram_[signalIdx * nBins_];
+                    bool updated = false;
+
+                    for (int smp = 0; smp < input.getNSamples(); ++smp)
+                    {
+                        if (x[smp] > 0)
+                        {
+                            if (count_[signalIdx] == 0)
+                            {
+                                y[MAX] = x[smp];
+                                y[MIN] = x[smp];
+                            }
+                            else
+                            {
+                                y[MAX] = max(y[MAX], x[smp]);
+                                y[MIN] = min(y[MIN], x[smp]);
+                            }
+                            sum_[signalIdx] += x[smp];
+                            count_[signalIdx]++;
+
+                            int bin = (int)floor((powerToDecibels(x[smp]) -
+                                        lowerLimitInDecibels_) /
+                                    binWidthInDecibels_);
+                            bin = min(max(bin, 0), nBins_ - 1);
+                            hist[bin]++;
+                            updated = true;
+                        }
+                    }
+
+                    if (updated)
+                        updateDescriptors(src, ear, chn, signalIdx);
+
+                    signalIdx++;
+                }
+            }
+        }
+    }
+
+    void LoudnessDescriptors::updateDescriptors(int src, int ear, int chn,
+            int signalIdx)
+    {
+        Real* y = output_.getSignalWritePointer(src, ear, chn, 0);
+        y[MEAN] = sum_[signalIdx] / count_[signalIdx];
+        y[N5] = getPercentile(95.0, src, ear, chn);
+        y[N10] = getPercentile(90.0, src, ear, chn);
+        y[LOUDNESS_RANGE] = powerToDecibels(y[N5]) -
+            powerToDecibels(getPercentile(10.0, src, ear, chn));
+    }
+
+    Real LoudnessDescriptors::getPercentile(Real percentile,
+            int src, int ear, int chn) const
+    {
+        int signalIdx = (src * nEars_ + ear) * nChannels_ + chn;
+        LOUDNESS_ASSERT(isPositiveAndLessThanUpper(signalIdx, (int)count_.size()));
+        if (count_[signalIdx] == 0)
+            return 0.0;
+
+        //find the bin holding the requested rank and interpolate within it
+        const long long* hist = &histogram_[signalIdx * nBins_];
+        Real rank = percentile / 100.0 * count_[signalIdx];
+        long long cumulativeCount = 0;
+        int bin = 0;
+        while ((bin < nBins_ - 1) && ((cumulativeCount + hist[bin]) < rank))
+            cumulativeCount += hist[bin++];
+
+        Real fraction = 0.0;
+        if (hist[bin] > 0)
+            fraction = (rank - cumulativeCount) / hist[bin];
+        Real level = lowerLimitInDecibels_ + (bin + fraction) * binWidthInDecibels_;
+
+        //estimate cannot fall outside of the observed range
+        const Real* y = output_.getSignalReadPointer(src, ear, chn, 0);
+        return min(max(decibelsToPower(level, -1e10), y[MIN]), y[MAX]);
+    }
+
+    long long LoudnessDescriptors::getNObservations(int src, int ear, int chn) const
+    {
+        int signalIdx = (src * nEars_ + ear) * nChannels_ + chn;
+        LOUDNESS_ASSERT(isPositiveAndLessThanUpper(signalIdx, (int)count_.size()));
+        return count_[signalIdx];
+    }
+
+    void LoudnessDescriptors::resetInternal()
+    {
+        sum_.assign (sum_.size(), 0.0);
+        count_.assign (count_.size(), 0);
+        histogram_.assign (histogram_.size(), 0);
+    }
+
+    void LoudnessDescriptors::saveStateInternal(RealVec &state) const
+    {
+        state.insert(state.end(), sum_.begin(), sum_.end());
+        state.insert(state.end(), count_.begin(), count_.end());
+        state.insert(state.end(), histogram_.begin(), histogram_.end());
+    }
+
+    bool LoudnessDescriptors::loadStateInternal(const RealVec &state,
+            int &pos)
+    {
+        int nValues = sum_.size() + count_.size() + histogram_.size();
+        if (pos < 0 || pos + nValues > (int)state.size())
+            return 0;
+        RealVec::const_iterator it = state.begin() + pos;
+        for (unsigned int i = 0; i < sum_.size(); ++i)
+            sum_[i] = *it++;
+        for (unsigned int i = 0; i < count_.size(); ++i)
+            count_[i] = (long long)*it++;
+        for (unsigned int i = 0; i < histogram_.size(); ++i)
+            histogram_[i] = (long long)*it++;
+        pos += nValues;
+        return 1;
+    }
+}
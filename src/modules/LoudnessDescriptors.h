@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef LOUDNESSDESCRIPTORS_H
+#define LOUDNESSDESCRIPTORS_H
+
+#include "../support/Module.h"
+
+namespace loudness{
+
+    /**
+     * @class LoudnessDescriptors
+     *
+     * @brief Computes scalar loudness descriptors of every signal in the input
+     * SignalBank incrementally, i.e. without storing the input time series.
+     *
+     * This is a terminal module intended to be attached to the output of a
+     * loudness model (e.g. short-term loudness in sones). Each input sample
+     * is treated as one observation of the signal it belongs to. Only
+     * positive values are considered, so silent frames are ignored (this
+     * matches meanSoneToDecibels() and maxSoneToDecibels() in the Python
+     * tools).
+     *
+     * The output SignalBank has the same number of sources, ears and channels
+     * as the input but holds one sample per descriptor, indexed by the
+     * Descriptor enum:
+     *
+     *  - MEAN: running mean.
+     *  - MAX: running maximum.
+     *  - MIN: running minimum.
+     *  - N5: the value exceeded 5% of the time (95th percentile).
+     *  - N10: the value exceeded 10% of the time (90th percentile).
+     *  - LOUDNESS_RANGE: the difference in decibels (10log10) between the 95th
+     *  and 10th percentiles, following the percentile range used by EBU Tech
+     *  3342 loudness range.
+     *
+     * The output is updated on every process call so the descriptors can be
+     * read at any time.
+     *
+     * Percentiles are estimated from a fixed histogram with bins equally
+     * spaced in decibels, so the memory per signal is constant and the
+     * estimation error is bounded by the bin width (default 0.1 dB). Values
+     * outside of the histogram range are counted in the lowest or highest bin.
+     *
+     * @sa Model::setOutputsToDescribe()
+     */
+    class LoudnessDescriptors : public Module
+    {
+    public:
+
+        enum Descriptor{
+            MEAN,
+            MAX,
+            MIN,
+            N5,
+            N10,
+            LOUDNESS_RANGE,
+            N_DESCRIPTORS
+        };
+
+        /**
+         * @brief Constructs a LoudnessDescriptors object.
+         *
+         * @param lowerLimitInDecibels Lower edge of the percentile histogram
+         * (10log10 of the input value).
+         * @param upperLimitInDecibels Upper edge of the percentile histogram.
+         * @param binWidthInDecibels Resolution of the percentile histogram.
+         */
+        LoudnessDescriptors(Real lowerLimitInDecibels = -40.0,
+                Real upperLimitInDecibels = 30.0,
+                Real binWidthInDecibels = 0.1);
+
+        virtual ~LoudnessDescriptors();
+
+        virtual Module* clone() const {return new LoudnessDescriptors(*this);};
+
+        /** Returns the estimated value exceeded (100 - percentile)% of the time
+         * for a given signal. */
+        Real getPercentile(Real percentile, int src = 0, int ear = 0, int chn = 0) const;
+
+        /** Returns the number of (positive) observations of a given signal. */
+        long long getNObservations(int src = 0, int ear = 0, int chn = 0) const;
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
+
+        void updateDescriptors(int src, int ear, int chn, int signalIdx);
+
+        Real lowerLimitInDecibels_, upperLimitInDecibels_, binWidthInDecibels_;
+        int nBins_, nChannels_, nEars_;
+        RealVec sum_;
+        vector<long long> count_, histogram_;
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "LoudnessIntegrator.h"
+
+namespace loudness{
+
+    LoudnessIntegrator::LoudnessIntegrator(Real cParam,
+            bool dioticPresentation,
+            Real attackTimeSTL,
+            Real releaseTimeSTL,
+            Real attackTimeLTL,
+            Real releaseTimeLTL) :
+        Module("LoudnessIntegrator"),
+        cParam_(cParam),
+        scale_(cParam),
+        dioticPresentation_(dioticPresentation),
+        attackTimeSTL_(attackTimeSTL),
+        releaseTimeSTL_(releaseTimeSTL),
+        attackTimeLTL_(attackTimeLTL),
+        releaseTimeLTL_(releaseTimeLTL)
+    {
+        LOUDNESS_DEBUG(name_ << ": Constructed.");
+    }
+
+    LoudnessIntegrator::~LoudnessIntegrator()
+    {};
+
+    bool LoudnessIntegrator::initializeInternal(const SignalBank &input)
+    {
+        LOUDNESS_ASSERT(input.getNChannels() > 1,
+                name_ << ": Insufficient number of input channels.");
+        LOUDNESS_ASSERT(isPositiveAndLessThanUpper(input.getNEars(), 3),
+                name_ << ": A human has no more than two ears.");
+
+        //assumes uniformly spaced ERB filters
+        Real camStep = input.getChannelSpacingInCams(); 
+        LOUDNESS_ASSERT(camStep > 0, 
+                name_ << ": Channel spacing (in Cam units) not set.");
+        scale_ = cParam_ * camStep;
+
+        int nEars = 1;
+        if (input.getNEars() == 1)
+        {
+            if (dioticPresentation_)
+                scale_ *= 2;
+        }
+        else if (!dioticPresentation_)
+        {
+            //loudness in each ear plus overall loudness
+            nEars = input.getNEars() + 1;
+        }
+
+        //filter coefficients, frame rate is the same at each stage
+        Real frameRate = input.getFrameRate();
+        attackCoefSTL_ = 1 - exp(-1.0 / (frameRate * attackTimeSTL_));
+        releaseCoefSTL_ = 1 - exp(-1.0 / (frameRate * releaseTimeSTL_));
+        attackCoefLTL_ = 1 - exp(-1.0 / (frameRate * attackTimeLTL_));
+        releaseCoefLTL_ = 1 - exp(-1.0 / (frameRate * releaseTimeLTL_));
+        LOUDNESS_DEBUG(name_ << ": Scaling factor: " << scale_
+                << ". STL coefficients: " << attackCoefSTL_
+                << ", " << releaseCoefSTL_
+                << ". LTL coefficients: " << attackCoefLTL_
+                << ", " << releaseCoefLTL_);
+
+        //instantaneous, short-term and long-term loudness per ear
+        output_.initialize(input.getNSources(), nEars, 3, 1, input.getFs());
+        output_.setFrameRate(frameRate);
+
+        return 1;
+    }
+
+    void LoudnessIntegrator::processInternal(const SignalBank &input)
+    {       
+        int nEars = output_.getNEars();
+        int nEarsToSum = getNEarsToProcess(input);
+        for (int src = 0; src < input.getNSources(); ++src)
+        {
+            //instantaneous loudness, identical ears are summed once
+            Real overallIL = 0.0, earIL = 0.0;
+            for (int ear = 0; ear < input.getNEars(); ++ear)
+            {
+                if (ear < nEarsToSum)
+                {
+                    const Real* inputSpecificLoudness = input
+                                                        .getSingleSampleReadPointer
+                                                        (src, ear, 0);
+                    earIL = 0.0;
+                    for (int chn = 0; chn < input.getNChannels(); ++chn)
+                        earIL += inputSpecificLoudness[chn];
+                    earIL *= scale_;
+                }
+
+                if (!dioticPresentation_)
+                    output_.setSample(src, ear, 0, 0, earIL);
+                overallIL += earIL;
+            }
+            if (dioticPresentation_ || (nEars == 3))
+                output_.setSample(src, nEars - 1, 0, 0, overallIL);
+
+            //short-term and long-term loudness from the previous states
+            for (int ear = 0; ear < nEars; ++ear)
+            {
+                Real* y = output_.getSingleSampleWritePointer(src, ear, 0);
+                Real coef = (y[0] > y[1]) ? attackCoefSTL_ : releaseCoefSTL_;
+                y[1] = coef * (y[0] - y[1]) + y[1];
+                coef = (y[1] > y[2]) ? attackCoefLTL_ : releaseCoefLTL_;
+                y[2] = coef * (y[1] - y[2]) + y[2];
+            }
+        }
+    }
+
+    //output SignalBanks are cleared so not to worry about filter state
+    void LoudnessIntegrator::resetInternal()
+    {}
+
+    void LoudnessIntegrator::hashConfiguration(unsigned long long& hash) const
+    {
+        Real config[] = {cParam_, scale_, attackTimeSTL_, releaseTimeSTL_,
+            attackTimeLTL_, releaseTimeLTL_};
+        int diotic = dioticPresentation_;
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(&diotic, sizeof(diotic), hash);
+    }
+}
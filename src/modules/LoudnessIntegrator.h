@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef LOUDNESSINTEGRATOR_H
+#define LOUDNESSINTEGRATOR_H
+
+#include "../support/Module.h"
+
+namespace loudness{
+
+    /**
+     * @class LoudnessIntegrator
+     *
+     * @brief Computes the instantaneous, short-term and long-term loudness
+     * from a specific loudness pattern in a single pass.
+     *
+     * This fuses InstantaneousLoudness followed by two ARAverager modules and
+     * gives identical results. The output SignalBank has three channels per
+     * ear: channel 0 holds the instantaneous loudness, channel 1 the
+     * short-term loudness and channel 2 the long-term loudness. The latter
+     * two channels also hold the filter states. Ears are configured as in
+     * InstantaneousLoudness.
+     *
+     * Models use a ChannelSelector per channel to expose each quantity under
+     * its own output name (see Model::configureTemporalIntegration()).
+     *
+     * @sa InstantaneousLoudness, ARAverager
+     */
+    class LoudnessIntegrator : public Module
+    {
+    public:
+ 
+        /** Constructs a LoudnessIntegrator.
+         *
+         * @param cParam A scaling factor applied to the instantaneous loudness.
+         * @param dioticPresentation See InstantaneousLoudness.
+         * @param attackTimeSTL Short-term loudness attack time in seconds.
+         * @param releaseTimeSTL Short-term loudness release time in seconds.
+         * @param attackTimeLTL Long-term loudness attack time in seconds.
+         * @param releaseTimeLTL Long-term loudness release time in seconds.
+         */
+        LoudnessIntegrator(Real cParam,
+                bool dioticPresentation,
+                Real attackTimeSTL,
+                Real releaseTimeSTL,
+                Real attackTimeLTL,
+                Real releaseTimeLTL);
+
+        virtual ~LoudnessIntegrator();
+
+        virtual Module* clone() const {return new LoudnessIntegrator(*this);};
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
+
+        Real cParam_, scale_;
+        bool dioticPresentation_;
+        Real attackTimeSTL_, releaseTimeSTL_;
+        Real attackTimeLTL_, releaseTimeLTL_;
+        Real attackCoefSTL_, releaseCoefSTL_;
+        Real attackCoefLTL_, releaseCoefLTL_;
+    };
+}
+
+#endif
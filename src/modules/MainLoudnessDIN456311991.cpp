@@ -203,4 +203,10 @@ namespace loudness{
     }
 
    void MainLoudnessDIN456311991::resetInternal(){};
+
+    void MainLoudnessDIN456311991::hashConfiguration(unsigned long long& hash) const
+    {
+        int config = outerEarType_;
+        hashBytes(&config, sizeof(config), hash);
+    }
 }
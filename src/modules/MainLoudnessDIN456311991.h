@@ -71,6 +71,8 @@ namespace loudness{
         MainLoudnessDIN456311991 (const OuterEarFilter& outerEarType = OuterEarFilter::FREEFIELD);
         virtual ~MainLoudnessDIN456311991();
 
+        virtual Module* clone() const {return new MainLoudnessDIN456311991(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -78,6 +80,7 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
         
         OuterEarFilter outerEarType_;
         RealVecVec dLL_;
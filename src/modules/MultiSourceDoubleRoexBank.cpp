@@ -91,8 +91,7 @@ namespace loudness{
         output_.setFrameRate (input.getFrameRate());
 
         //filter variables
-        wPassive_.resize (nFilters_);
-        wActive_.resize (nFilters_);
+        RealVecVec wPassive (nFilters_), wActive (nFilters_);
         maxGdB_.resize (nFilters_);
         thirdGainTerm_.resize (nFilters_);
 
@@ -144,14 +143,16 @@ namespace loudness{
                     }
 
                     //Eq. 4 and Eq. 7
-                    wPassive_[i].push_back ((1 + pgPassive) * exp (-pgPassive)); 
-                    wActive_[i].push_back ((1 + pgActive) * exp (-pgActive)); 
+                    wPassive[i].push_back ((1 + pgPassive) * exp (-pgPassive)); 
+                    wActive[i].push_back ((1 + pgActive) * exp (-pgActive)); 
                 }
                 else
                     break;
                 j++;
             }
         }
+        wPassive_ = TableRegistry::share (wPassive);
+        wActive_ = TableRegistry::share (wActive);
         LOUDNESS_DEBUG(name_ << ": Passive and active filters configured.");
         LOUDNESS_DEBUG(name_ << ": Excitation pattern will be scaled by: " 
                 << scalingFactor_);
@@ -162,6 +163,9 @@ namespace loudness{
 
     void MultiSourceDoubleRoexBank::processInternal(const SignalBank &input)
     {
+        const RealVecVec& wPassive = *wPassive_;
+        const RealVecVec& wActive = *wActive_;
+
         for (int ear = 0; ear < input.getNEars(); ++ear)
         {
             // First to passive filtering
@@ -181,8 +185,8 @@ namespace loudness{
                     Real excitationLinP = 0.0;
 
                     //passive filter output
-                    for (uint j = 0; j < wPassive_[i].size(); ++j)
-                        excitationLinP += wPassive_[i][j] * inputSpectrum[j];
+                    for (uint j = 0; j < wPassive[i].size(); ++j)
+                        excitationLinP += wPassive[i][j] * inputSpectrum[j];
 
                     outputExcitation[i] = excitationLinP;
 
@@ -232,8 +236,8 @@ namespace loudness{
                     Real excitationLinA = 0.0;
 
                     //active filter output
-                    for (uint j = 0; j < wActive_[i].size(); ++j)
-                        excitationLinA += wActive_[i][j] * inputSpectrum[j];
+                    for (uint j = 0; j < wActive[i].size(); ++j)
+                        excitationLinA += wActive[i][j] * inputSpectrum[j];
 
                     // Use the gain derived from all inputs
                     excitationLinA *= gainOut[i];
@@ -263,4 +267,14 @@ namespace loudness{
     }
 
     void MultiSourceDoubleRoexBank::resetInternal(){};
+
+    void MultiSourceDoubleRoexBank::hashConfiguration(unsigned long long& hash) const
+    {
+        Real config[] = {camLo_, camHi_, camStep_, scalingFactor_};
+        //the interpolation may be turned off on initialisation
+        int interpolation[] = {isExcitationPatternInterpolated_,
+            isExcitationPatternInterpolated_ && isInterpolationCubic_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(interpolation, sizeof(interpolation), hash);
+    }
 }
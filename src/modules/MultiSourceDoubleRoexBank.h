@@ -21,6 +21,7 @@
 #define MultiSourceDoubleRoexBank_H
 
 #include "../support/Module.h"
+#include "../support/TableRegistry.h"
 #include "../thirdParty/spline/Spline.h"
 
 namespace loudness{
@@ -78,6 +79,8 @@ namespace loudness{
 
         virtual ~MultiSourceDoubleRoexBank();
 
+        virtual Module* clone() const {return new MultiSourceDoubleRoexBank(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -85,12 +88,14 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         Real camLo_, camHi_, camStep_, scalingFactor_;
         bool isExcitationPatternInterpolated_, isInterpolationCubic_;
         int nFilters_;
         RealVec maxGdB_, thirdGainTerm_, cams_, logExcitation_;
-        RealVecVec wPassive_, wActive_;
+        std::shared_ptr<const RealVecVec> wPassive_, wActive_;
         spline spline_;
     };
 }
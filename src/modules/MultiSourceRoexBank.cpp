@@ -93,10 +93,10 @@ namespace loudness{
         const Real p51_1k = 4000.0 / centreFreqToCambridgeERB (1000.0);
 
         //p upper is level invariant
-        pu_.assign (nFilters_, 0.0);
+        RealVec pu (nFilters_, 0.0);
         
         //p lower is level dependent
-        pl_.assign (nFilters_, 0.0);
+        RealVec pl (nFilters_, 0.0);
 
         output_.initialize (input.getNSources(),
                             input.getNEars(),
@@ -118,10 +118,12 @@ namespace loudness{
             //get the ERB of the filter
             Real erb = centreFreqToCambridgeERB (fc);
             //ANSI S3.4 sec 3.5 p.11
-            pu_[i] = 4.0 * fc / erb;
+            pu[i] = 4.0 * fc / erb;
             //from Eq (3)
-            pl_[i] = 0.35 * (pu_[i] / p51_1k);
+            pl[i] = 0.35 * (pu[i] / p51_1k);
         }
+        pu_ = TableRegistry::share (pu);
+        pl_ = TableRegistry::share (pl);
         
         //generate lookup table for rounded exponential
         generateRoexTable(1024);
@@ -131,6 +133,10 @@ namespace loudness{
 
     void MultiSourceRoexBank::processInternal(const SignalBank &input)
     {
+        const RealVec& pu = *pu_;
+        const RealVec& pl = *pl_;
+        const RealVec& roexTable = *roexTable_;
+
         for (int ear = 0; ear < input.getNEars(); ++ear)
         {
             /*
@@ -181,19 +187,19 @@ namespace loudness{
                     if (g < 0) //lower skirt - level dependent
                     {
                         //Complete Eq (3)
-                        p = pu_[i] - (pl_[i] * compLevel[j]); //51dB subtracted above
+                        p = pu[i] - (pl[i] * compLevel[j]); //51dB subtracted above
                         p = max(p, 0.1); //p can go negative for very high levels
                         pg = -p * g; //p * abs (g)
                     }
                     else //upper skirt
                     {
-                        pg = pu_[i] * g; //p * abs(g)
+                        pg = pu[i] * g; //p * abs(g)
                     }
                     
                     //excitation
                     int idx = (int)(pg / step_ + 0.5);
                     idx = min (idx, roexIdxLimit_);
-                    roex[j++] = roexTable_[idx];
+                    roex[j++] = roexTable[idx];
                 }
 
                 // filter excitation for each source
@@ -219,7 +225,7 @@ namespace loudness{
     {
         size = max (size, 512);
         roexIdxLimit_ = size - 1;
-        roexTable_.resize (size);
+        RealVec roexTable (size);
 
         double pgLim = 20.48; //end value is 20.46
         double pg;
@@ -228,7 +234,13 @@ namespace loudness{
         for (int i = 0; i < size; ++i)
         {
             pg = step_ * i;
-            roexTable_[i] = (1 + pg) * exp (-pg);
+            roexTable[i] = (1 + pg) * exp (-pg);
         }
+        roexTable_ = TableRegistry::share (roexTable);
+    }
+
+    void MultiSourceRoexBank::hashConfiguration(unsigned long long& hash) const
+    {
+        hashBytes(&camStep_, sizeof(camStep_), hash);
     }
 }
@@ -21,6 +21,7 @@
 #define MultiSourceRoexBank_H
 
 #include "../support/Module.h"
+#include "../support/TableRegistry.h"
 #include "../thirdParty/spline/Spline.h"
 
 namespace loudness{
@@ -63,6 +64,8 @@ namespace loudness{
 
         virtual ~MultiSourceRoexBank();
 
+        virtual Module* clone() const {return new MultiSourceRoexBank(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
@@ -70,6 +73,8 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         void generateRoexTable(int size = 1024);
 
@@ -77,7 +82,7 @@ namespace loudness{
         int nFilters_, roexIdxLimit_;
         Real step_;
         vector<vector<int> > rectBinIndices_;
-        RealVec pu_, pl_, roexTable_;
+        std::shared_ptr<const RealVec> pu_, pl_, roexTable_;
     };
 }
 
@@ -127,4 +127,12 @@ namespace loudness{
     }
 
    void OctaveBank::resetInternal(){};
+
+    void OctaveBank::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {order_, nBandsToRemoveFromEnd_, isThirdOctave_,
+            isOutputInDecibels_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(&exponent_, sizeof(exponent_), hash);
+    }
 }
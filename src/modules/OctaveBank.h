@@ -63,6 +63,8 @@ namespace loudness{
 
         virtual ~OctaveBank();
 
+        virtual Module* clone() const {return new OctaveBank(*this);};
+
         /** Sets the centre frequencies of the filters in Hz. @centreFreqs must
          * have at least 1 element. */
         void setCentreFreqs (RealVec centreFreqs);
@@ -74,6 +76,7 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         int order_, nBandsToRemoveFromEnd_;
         bool isThirdOctave_, isOutputInDecibels_;
@@ -49,6 +49,8 @@ namespace loudness{
 
         virtual ~PeakFollower();
 
+        virtual Module* clone() const {return new PeakFollower(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
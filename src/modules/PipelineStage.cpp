@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "PipelineStage.h"
+#include <chrono>
+
+namespace loudness{
+
+    PipelineStage::PipelineStage(int queueDepth, Real spinTime) :
+        Module("PipelineStage"),
+        queueDepth_(max(queueDepth, 1)),
+        spinTime_(spinTime),
+        isSlotAcquired_(false),
+        head_(0),
+        tail_(0),
+        stop_(false),
+        nParkedThreads_(0)
+    {}
+
+    PipelineStage::~PipelineStage()
+    {
+        if (worker_.joinable())
+        {
+            synchronize();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            frameQueued_.notify_all();
+            worker_.join();
+        }
+    }
+
+    bool PipelineStage::initializeInternal(const SignalBank &input)
+    {
+        synchronize();
+
+        output_.initialize(input);
+        slots_.assign(queueDepth_, SignalBank());
+        for (auto &slot : slots_)
+            slot.initialize(input);
+        head_ = 0;
+        tail_ = 0;
+        isSlotAcquired_ = false;
+
+        if (!worker_.joinable())
+            worker_ = std::thread(&PipelineStage::workerLoop, this);
+
+        return 1;
+    }
+
+    void PipelineStage::processInternal(const SignalBank &input)
+    {
+        //back-pressure: wait for a free slot
+        long long tail = tail_.load(std::memory_order_relaxed);
+        waitUntil([this, tail]{
+                return (tail - head_.load()) < queueDepth_;}, frameProcessed_);
+
+        slots_[tail % queueDepth_].copySamples(input);
+        slots_[tail % queueDepth_].setUnchanged(input.isUnchanged());
+        slots_[tail % queueDepth_].setEarsIdentical(input.areEarsIdentical());
+        slots_[tail % queueDepth_].setChangedChannels(
+                input.getChangedChannelsBegin(), input.getChangedChannelsEnd());
+        isSlotAcquired_ = true;
+    }
+
+    void PipelineStage::processTargetModules()
+    {
+        long long tail = tail_.load(std::memory_order_relaxed);
+
+        //untriggered frames are queued too, targets must see them
+        if (!isSlotAcquired_)
+            waitUntil([this, tail]{
+                    return (tail - head_.load()) < queueDepth_;}, frameProcessed_);
+
+        slots_[tail % queueDepth_].setTrig(output_.getTrig());
+        isSlotAcquired_ = false;
+        tail_.store(tail + 1);
+        notify(frameQueued_);
+    }
+
+    void PipelineStage::workerLoop()
+    {
+        while (true)
+        {
+            long long head = head_.load(std::memory_order_relaxed);
+            waitUntil([this, head]{
+                    return stop_ || (head != tail_.load());}, frameQueued_);
+            if (head == tail_.load())
+                return;
+
+            const SignalBank& frame = slots_[head % queueDepth_];
+            for (uint i = 0; i < targetModules_.size(); i++)
+                targetModules_[i] -> process(frame);
+
+            head_.store(head + 1);
+            notify(frameProcessed_);
+        }
+    }
+
+    void PipelineStage::synchronize()
+    {
+        waitUntil([this]{
+                return head_.load() == tail_.load();}, frameProcessed_);
+    }
+
+    void PipelineStage::waitUntil(const std::function<bool()>& condition,
+            std::condition_variable& event)
+    {
+        if (condition())
+            return;
+
+        auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration<Real>(spinTime_);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (condition())
+                return;
+            std::this_thread::yield();
+        }
+
+        /*
+         * The counter and the queue indices are sequentially consistent, so
+         * either the notifying thread sees this thread parked or the
+         * condition below sees the new index.
+         */
+        std::unique_lock<std::mutex> lock(mutex_);
+        nParkedThreads_++;
+        event.wait(lock, condition);
+        nParkedThreads_--;
+    }
+
+    void PipelineStage::notify(std::condition_variable& event)
+    {
+        if (nParkedThreads_.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            event.notify_all();
+        }
+    }
+
+    void PipelineStage::resetInternal()
+    {
+        synchronize();
+    }
+
+    int PipelineStage::getQueueDepth() const
+    {
+        return queueDepth_;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef PIPELINESTAGE_H
+#define PIPELINESTAGE_H
+
+#include "../support/Module.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace loudness{
+
+    /**
+     * @class PipelineStage
+     *
+     * @brief Passes its input to its target modules on a separate thread.
+     *
+     * The input SignalBank (including its trigger) is copied into a bounded
+     * ring of frames which is consumed by a worker thread owned by this
+     * module. The worker calls process() on each target module with the
+     * queued frames in order, so the targets see exactly the same sequence of
+     * inputs as they would without the stage. The ring is a lock-free
+     * single-producer/single-consumer queue; when it is full, process() waits
+     * for the worker (back-pressure), so at most queueDepth frames are in
+     * flight.
+     *
+     * Because process() returns before the targets have processed the
+     * frame, the outputs of modules downstream of a stage lag behind the
+     * input. Call synchronize() to wait until all queued frames have been
+     * processed before reading them. reset() synchronises before the targets
+     * are reset.
+     *
+     * As in ThreadPool, a waiting thread (the worker waiting for a frame, or
+     * the producer waiting for a free slot or for synchronize()) spins for
+     * up to the spin time and then parks on a condition variable, so an
+     * idle stage does not keep waking its thread.
+     *
+     * Model::setPipelineUsed() inserts stages into a model.
+     */
+    class PipelineStage : public Module
+    {
+    public:
+
+        /** Constructs a PipelineStage holding up to queueDepth frames.
+         * Waiting threads spin for spinTime seconds before parking. */
+        PipelineStage(int queueDepth = 8, Real spinTime = 0.0002);
+
+        virtual ~PipelineStage();
+
+        /** Waits until the targets have processed all queued frames. */
+        void synchronize();
+
+        /** Returns the maximum number of queued frames. */
+        int getQueueDepth() const;
+
+    private:
+        virtual bool initializeInternal(const SignalBank &input);
+        virtual bool initializeInternal(){return 0;};
+        virtual void processInternal(const SignalBank &input);
+        virtual void processInternal(){};
+        virtual void resetInternal();
+        virtual void processTargetModules();
+
+        /** Spins, then parks on event until condition holds. */
+        void waitUntil(const std::function<bool()>& condition,
+                std::condition_variable& event);
+
+        /** Wakes the threads parked on event, if any. */
+        void notify(std::condition_variable& event);
+
+        void workerLoop();
+
+        int queueDepth_;
+        Real spinTime_;
+        bool isSlotAcquired_;
+        vector<SignalBank> slots_;
+        std::atomic<long long> head_, tail_;
+        std::atomic<bool> stop_;
+        std::atomic<int> nParkedThreads_;
+        std::mutex mutex_;
+        std::condition_variable frameQueued_, frameProcessed_;
+        std::thread worker_;
+    };
+}
+
+#endif
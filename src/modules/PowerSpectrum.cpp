@@ -31,9 +31,42 @@ namespace loudness{
             windowSizes_(windowSizes),
             sampleSpectrumUniformly_(sampleSpectrumUniformly),
             normalisation_ (normalisation),
-            referenceValue_ (referenceValue)
+            referenceValue_ (referenceValue),
+            areBandUpdatesDecimated_(false),
+            isPrimed_(false),
+            isFullyChangedOnce_(false),
+            minimumOverlap_(0.875),
+            updateInterpolation_(HOLD)
     {}
 
+    PowerSpectrum::PowerSpectrum(const PowerSpectrum& other)
+        :   Module(other),
+            bandFreqsHz_(other.bandFreqsHz_),
+            normFactor_(other.normFactor_),
+            windowSizes_(other.windowSizes_),
+            sampleSpectrumUniformly_(other.sampleSpectrumUniformly_),
+            normalisation_ (other.normalisation_),
+            referenceValue_ (other.referenceValue_),
+            bandBinIndices_(other.bandBinIndices_),
+            areBandUpdatesDecimated_(other.areBandUpdatesDecimated_),
+            isPrimed_(other.isPrimed_),
+            isFullyChangedOnce_(other.isFullyChangedOnce_),
+            minimumOverlap_(other.minimumOverlap_),
+            updateInterpolation_(other.updateInterpolation_),
+            bandUpdateIntervals_(other.bandUpdateIntervals_),
+            bandChannelOffsets_(other.bandChannelOffsets_),
+            hopsToUpdate_(other.hopsToUpdate_),
+            lastUpdate_(other.lastUpdate_),
+            previousUpdate_(other.previousUpdate_)
+    {
+        ffts_.resize(other.ffts_.size());
+        for (uint i = 0; i < ffts_.size(); ++i)
+        {
+            for (const auto &fft : other.ffts_[i])
+                ffts_[i].push_back(unique_ptr<FFT> (new FFT(*fft)));
+        }
+    }
+
     PowerSpectrum::~PowerSpectrum()
     {}
 
@@ -54,18 +87,21 @@ namespace loudness{
         //work out FFT configuration (constrain to power of 2)
         int largestWindowSize = input.getNSamples();
         vector<int> fftSize(nWindows, nextPowerOfTwo(largestWindowSize));
-        if(sampleSpectrumUniformly_)
+        if(!sampleSpectrumUniformly_)
         {
-            ffts_.push_back(unique_ptr<FFT> (new FFT(fftSize[0]))); 
-            ffts_[0] -> initialize();
+            for(int w=0; w<nWindows; w++)
+                fftSize[w] = nextPowerOfTwo(windowSizes_[w]);
         }
-        else
+
+        //one set of FFTs per slice processed in parallel
+        int nFFTs = sampleSpectrumUniformly_ ? 1 : nWindows;
+        ffts_.resize(getNSlices(input.getNSources(), input.getNEars()));
+        for (auto &fftSet : ffts_)
         {
-            for(int w=0; w<nWindows; w++)
+            for(int w=0; w<nFFTs; w++)
             {
-                fftSize[w] = nextPowerOfTwo(windowSizes_[w]);
-                ffts_.push_back(unique_ptr<FFT> (new FFT(fftSize[w]))); 
-                ffts_[w] -> initialize();
+                fftSet.push_back(unique_ptr<FFT> (new FFT(fftSize[w]))); 
+                fftSet[w] -> initialize();
             }
         }
 
@@ -148,47 +184,262 @@ namespace loudness{
                     << fs * (bandBinIndices_[i][1] - 1) / float(fftSize[i])); 
         }
 
+        //first output channel of each band
+        bandChannelOffsets_.assign(nWindows + 1, 0);
+        for(int i=0; i<nWindows; i++)
+        {
+            bandChannelOffsets_[i+1] = bandChannelOffsets_[i] +
+                bandBinIndices_[i][1] - bandBinIndices_[i][0];
+        }
+
+        //hops between band updates
+        bandUpdateIntervals_.assign(nWindows, 1);
+        if (areBandUpdatesDecimated_)
+        {
+            LOUDNESS_ASSERT((minimumOverlap_ >= 0) && (minimumOverlap_ < 1),
+                    name_ << ": Minimum overlap must be in [0, 1).");
+
+            Real hopSize = fs / input.getFrameRate();
+            for(int i=0; i<nWindows; i++)
+            {
+                bandUpdateIntervals_[i] = max(1, (int)floor(windowSizes_[i] *
+                            (1 - minimumOverlap_) / hopSize + 1e-9));
+                LOUDNESS_DEBUG(name_ << ": Band " << i << " updated every "
+                        << bandUpdateIntervals_[i] << " hops.");
+            }
+
+            if (updateInterpolation_ == LINEAR)
+            {
+                lastUpdate_.initialize(output_);
+                previousUpdate_.initialize(output_);
+            }
+        }
+
+        resetInternal();
+
         return 1;
     }
 
+    void PowerSpectrum::processBand(const SignalBank &input,
+            int src, int ear, int band, FFT &fft, Real* powers)
+    {
+        //Do the FFT
+        fft.process(input.getSignalReadPointer(src, ear, band),
+                    windowSizes_[band]);
+
+        //Extract components from band and compute powers
+        Real re, im;
+        int bin = bandBinIndices_[band][0];
+        while(bin < bandBinIndices_[band][1])
+        {
+            re = fft.getReal(bin);
+            im = fft.getImag(bin++);
+            *powers++ = normFactor_[band] * (re*re + im*im);
+        }
+    }
+
     void PowerSpectrum::processInternal(const SignalBank &input)
     {
-        int fftIdx = 0;
+        if (areBandUpdatesDecimated_)
+        {
+            processDecimated(input);
+            return;
+        }
+
+        int nWindows = windowSizes_.size();
+        processSlices(input.getNSources(), input.getNEars(),
+                [&](int src, int ear, int bufferIdx)
+        {
+            vector<unique_ptr<FFT>>& ffts = ffts_[bufferIdx];
+            Real* outputSignal = output_.getSingleSampleWritePointer
+                                 (src, ear, 0);
+
+            for (int chn = 0; chn < nWindows; ++chn)
+            {
+                int fftIdx = sampleSpectrumUniformly_ ? 0 : chn;
+                processBand(input, src, ear, chn, *ffts[fftIdx],
+                        outputSignal + bandChannelOffsets_[chn]);
+            }
+        });
+    }
+
+    void PowerSpectrum::processDecimated(const SignalBank &input)
+    {
         int nWindows = windowSizes_.size();
-        for (int src = 0; src < input.getNSources(); ++src)
+        int nSources = input.getNSources();
+        int nEars = input.getNEars();
+        bool isInterpolated = (updateInterpolation_ == LINEAR);
+
+        //held bands can differ between ears even when the input ears do not,
+        //so only the bands updated at this hop are copied across ears
+        int nEarsToProcess = getNEarsToProcess(input);
+        areInputEarsIdentical_ = false;
+
+        //latest update of each band
+        SignalBank& updates = isInterpolated ? lastUpdate_ : output_;
+
+        processSlices(nSources, nEarsToProcess,
+                [&](int src, int ear, int bufferIdx)
+        {
+            vector<unique_ptr<FFT>>& ffts = ffts_[bufferIdx];
+            for (int chn = 0; chn < nWindows; ++chn)
+            {
+                if (hopsToUpdate_[chn] > 0)
+                    continue;
+
+                int offset = bandChannelOffsets_[chn];
+                if (isInterpolated)
+                {
+                    const Real* last = updates.getSingleSampleReadPointer
+                                       (src, ear, offset);
+                    std::copy(last, last + bandChannelOffsets_[chn+1] - offset,
+                            previousUpdate_.getSingleSampleWritePointer
+                            (src, ear, offset));
+                }
+
+                int fftIdx = sampleSpectrumUniformly_ ? 0 : chn;
+                processBand(input, src, ear, chn, *ffts[fftIdx],
+                        updates.getSingleSampleWritePointer(src, ear, offset));
+            }
+        });
+
+        //bands updated at this hop
+        int changedBegin = output_.getNChannels(), changedEnd = 0;
+        for (int chn = 0; chn < nWindows; ++chn)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
+            if (hopsToUpdate_[chn] > 0)
+                continue;
+
+            int begin = bandChannelOffsets_[chn];
+            int end = bandChannelOffsets_[chn+1];
+            changedBegin = min(changedBegin, begin);
+            changedEnd = max(changedEnd, end);
+
+            for (int src = 0; src < nSources; ++src)
             {
-                //get a single sample pointer for moving through channels
-                Real* outputSignal = output_.getSingleSampleWritePointer
-                                     (src, ear, 0);
+                for (int ear = nEarsToProcess; ear < nEars; ++ear)
+                {
+                    const Real* first = updates.getSingleSampleReadPointer
+                                        (src, 0, begin);
+                    std::copy(first, first + end - begin,
+                            updates.getSingleSampleWritePointer
+                            (src, ear, begin));
+                    if (isInterpolated)
+                    {
+                        first = previousUpdate_.getSingleSampleReadPointer
+                                (src, 0, begin);
+                        std::copy(first, first + end - begin,
+                                previousUpdate_.getSingleSampleWritePointer
+                                (src, ear, begin));
+                    }
+                }
+            }
+        }
+
+        //interpolate between the last two updates, lagging by one interval
+        if (isInterpolated)
+        {
+            if (!isPrimed_)
+                previousUpdate_.copySamples(lastUpdate_);
 
-                for (int chn = 0; chn < nWindows; ++chn)
+            for (int src = 0; src < nSources; ++src)
+            {
+                for (int ear = 0; ear < nEars; ++ear)
                 {
-                    if(!sampleSpectrumUniformly_)
-                        fftIdx = chn;
-
-                    //Do the FFT
-                    ffts_[fftIdx] -> process(input.getSignalReadPointer
-                                             (src, ear, chn),
-                                             windowSizes_[chn]);
-
-                    //Extract components from band and compute powers
-                    Real re, im;
-                    int bin = bandBinIndices_[chn][0];
-                    while(bin < bandBinIndices_[chn][1])
+                    const Real* last = lastUpdate_.getSingleSampleReadPointer
+                                       (src, ear, 0);
+                    const Real* previous = previousUpdate_
+                                           .getSingleSampleReadPointer
+                                           (src, ear, 0);
+                    Real* outputSignal = output_.getSingleSampleWritePointer
+                                         (src, ear, 0);
+                    for (int chn = 0; chn < nWindows; ++chn)
                     {
-                        re = ffts_[fftIdx] -> getReal(bin);
-                        im = ffts_[fftIdx] -> getImag(bin++);
-                        *outputSignal++ = normFactor_[chn] * (re*re + im*im);
+                        int interval = bandUpdateIntervals_[chn];
+                        int hopsSinceUpdate = hopsToUpdate_[chn] > 0 ?
+                            interval - hopsToUpdate_[chn] : 0;
+                        Real weight = hopsSinceUpdate / (Real)interval;
+                        for (int i = bandChannelOffsets_[chn];
+                                i < bandChannelOffsets_[chn+1]; ++i)
+                        {
+                            if (interval == 1)
+                                outputSignal[i] = last[i];
+                            else
+                                outputSignal[i] = previous[i] +
+                                    weight * (last[i] - previous[i]);
+                        }
                     }
                 }
             }
         }
+
+        for (int chn = 0; chn < nWindows; ++chn)
+        {
+            if (hopsToUpdate_[chn] == 0)
+                hopsToUpdate_[chn] = bandUpdateIntervals_[chn];
+            --hopsToUpdate_[chn];
+        }
+        isPrimed_ = true;
+
+        //targets may not hold the output before the state was loaded
+        if (isFullyChangedOnce_)
+            isFullyChangedOnce_ = false;
+        else if (!isInterpolated && (changedBegin >= changedEnd))
+            output_.setUnchanged(true);
+        else if (!isInterpolated)
+            output_.setChangedChannels(changedBegin, changedEnd);
     }
 
     void PowerSpectrum::resetInternal()
-    {}
+    {
+        hopsToUpdate_.assign(bandUpdateIntervals_.size(), 0);
+        isPrimed_ = false;
+        isFullyChangedOnce_ = false;
+        if (lastUpdate_.isInitialized())
+        {
+            lastUpdate_.reset();
+            previousUpdate_.reset();
+        }
+    }
+
+    void PowerSpectrum::saveStateInternal(RealVec &state) const
+    {
+        if (!areBandUpdatesDecimated_)
+            return;
+
+        for (int hops : hopsToUpdate_)
+            state.push_back(hops);
+        state.push_back(isPrimed_);
+        if (updateInterpolation_ == LINEAR)
+        {
+            appendState(state, lastUpdate_);
+            appendState(state, previousUpdate_);
+        }
+    }
+
+    bool PowerSpectrum::loadStateInternal(const RealVec &state, int &pos)
+    {
+        if (!areBandUpdatesDecimated_)
+            return 1;
+
+        Real value = 0;
+        for (int &hops : hopsToUpdate_)
+        {
+            if (!extractState(state, pos, value))
+                return 0;
+            hops = (int)value;
+        }
+        if (!extractState(state, pos, value))
+            return 0;
+        isPrimed_ = (value != 0);
+        if ((updateInterpolation_ == LINEAR) &&
+                (!extractState(state, pos, lastUpdate_) ||
+                 !extractState(state, pos, previousUpdate_)))
+            return 0;
+
+        isFullyChangedOnce_ = true;
+        return 1;
+    }
 
     void PowerSpectrum::setNormalisation(const Normalisation normalisation)
     {
@@ -199,4 +450,45 @@ namespace loudness{
     {
         referenceValue_ = referenceValue;
     }
+
+    void PowerSpectrum::setBandUpdatesDecimated(bool areBandUpdatesDecimated,
+            Real minimumOverlap, const UpdateInterpolation& updateInterpolation)
+    {
+        areBandUpdatesDecimated_ = areBandUpdatesDecimated;
+        minimumOverlap_ = minimumOverlap;
+        updateInterpolation_ = updateInterpolation;
+    }
+
+    const vector<int>& PowerSpectrum::getBandUpdateIntervals() const
+    {
+        return bandUpdateIntervals_;
+    }
+
+    bool PowerSpectrum::isEquivalentTo(const Module& other) const
+    {
+        const PowerSpectrum* that = dynamic_cast<const PowerSpectrum*>(&other);
+        return that &&
+               bandFreqsHz_ == that -> bandFreqsHz_ &&
+               windowSizes_ == that -> windowSizes_ &&
+               sampleSpectrumUniformly_ == that -> sampleSpectrumUniformly_ &&
+               normalisation_ == that -> normalisation_ &&
+               referenceValue_ == that -> referenceValue_ &&
+               areBandUpdatesDecimated_ == that -> areBandUpdatesDecimated_ &&
+               (!areBandUpdatesDecimated_ ||
+                (minimumOverlap_ == that -> minimumOverlap_ &&
+                 updateInterpolation_ == that -> updateInterpolation_));
+    }
+
+    void PowerSpectrum::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {sampleSpectrumUniformly_, normalisation_,
+            areBandUpdatesDecimated_, updateInterpolation_};
+        Real params[] = {referenceValue_, minimumOverlap_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(params, sizeof(params), hash);
+        hashBytes(bandFreqsHz_.data(), bandFreqsHz_.size() * sizeof(Real),
+                hash);
+        hashBytes(windowSizes_.data(), windowSizes_.size() * sizeof(int),
+                hash);
+    }
 }
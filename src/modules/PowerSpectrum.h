@@ -69,6 +69,19 @@ namespace loudness{
      * pressure reference of 20 micro pascals. Use setReferenceValue() to change
      * this.
      *
+     * At high frame rates the spectra of the longer windows change little from
+     * one hop to the next. setBandUpdatesDecimated() recomputes each band
+     * only every k hops, where k is the largest number of hops for which
+     * successive windows of that band still overlap by a minimum fraction,
+     * e.g. 8 hops for a 64 ms window at a 1 ms hop and an overlap of 0.875.
+     * In between, the last values are either held or interpolated linearly
+     * between the last two updates, which delays that band by k hops (less
+     * than (1 - overlap) times its window length). The module is then no
+     * longer stateless. When held, the output flags the channels of the bands
+     * updated at this hop as the changed channels (see
+     * SignalBank::setChangedChannels()), or the whole output as unchanged if
+     * no band was updated.
+     *
      * @sa FrameGenerator, Window
      */
     class PowerSpectrum: public Module
@@ -80,6 +93,11 @@ namespace loudness{
             ENERGY,
             AVERAGE_POWER
         };
+
+        enum UpdateInterpolation{
+            HOLD,
+            LINEAR
+        };
  
         /**
          * @brief Constructs a PowerSpectrum object.
@@ -95,18 +113,51 @@ namespace loudness{
                 const Normalisation& normalisation = AVERAGE_POWER,
                 Real referenceValue = 2e-5);
 
+        /** The copy shares the FFT plans of other. */
+        PowerSpectrum(const PowerSpectrum& other);
+
         virtual ~PowerSpectrum();
 
+        virtual Module* clone() const {return new PowerSpectrum(*this);};
+
         void setNormalisation(const Normalisation normalisation);
 
         void setReferenceValue(Real referenceValue);
 
+        /**
+         * @brief Sets whether bands are recomputed at a lower rate than the
+         * input frame rate. Call this before initialize().
+         *
+         * @param areBandUpdatesDecimated Set true to decimate band updates.
+         * @param minimumOverlap Minimum fraction of a window shared by
+         * successive updates of its band, in [0, 1).
+         * @param updateInterpolation How bands are estimated between updates.
+         */
+        void setBandUpdatesDecimated(bool areBandUpdatesDecimated,
+                Real minimumOverlap = 0.875,
+                const UpdateInterpolation& updateInterpolation = HOLD);
+
+        /** Returns the number of hops between updates of each band. */
+        const vector<int>& getBandUpdateIntervals() const;
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return !areBandUpdatesDecimated_;};
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
+
+        /** Writes the powers of one band of a slice to powers. */
+        void processBand(const SignalBank &input, int src, int ear, int band,
+                FFT &fft, Real* powers);
+
+        /** Band processing when updates are decimated. */
+        void processDecimated(const SignalBank &input);
 
         RealVec bandFreqsHz_, normFactor_;
         vector<int> windowSizes_;
@@ -114,7 +165,13 @@ namespace loudness{
         Normalisation normalisation_;
         Real referenceValue_;
         vector<vector<int> > bandBinIndices_; 
-        vector<unique_ptr<FFT>> ffts_;
+        vector<vector<unique_ptr<FFT>>> ffts_;
+
+        bool areBandUpdatesDecimated_, isPrimed_, isFullyChangedOnce_;
+        Real minimumOverlap_;
+        UpdateInterpolation updateInterpolation_;
+        vector<int> bandUpdateIntervals_, bandChannelOffsets_, hopsToUpdate_;
+        SignalBank lastUpdate_, previousUpdate_;
     };
 }
 
@@ -51,12 +51,16 @@ namespace loudness{
 
         virtual ~RoexBankANSIS342007();
 
+        virtual Module* clone() const {return new RoexBankANSIS342007(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         int nFilters_;
         Real camLo_, camHi_, camStep_;
@@ -142,6 +142,24 @@ namespace loudness{
         audioBuffer_.zeroSignals();
         bufferIdx_ = 0;
     }
+
+    void SMA::saveStateInternal(RealVec &state) const
+    {
+        state.push_back(bufferIdx_);
+        appendState(state, runningSumBuf_);
+        appendState(state, audioBuffer_);
+    }
+
+    bool SMA::loadStateInternal(const RealVec &state, int &pos)
+    {
+        Real bufferIdx = 0;
+        if (!extractState(state, pos, bufferIdx) ||
+                !extractState(state, pos, runningSumBuf_) ||
+                !extractState(state, pos, audioBuffer_))
+            return 0;
+        bufferIdx_ = (int)bufferIdx;
+        return 1;
+    }
  
 
     void SMA::setWindowSize(int windowSize)
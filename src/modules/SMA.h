@@ -57,6 +57,8 @@ namespace loudness{
         SMA(int windowSize=5, bool average=true, bool squareInput=false);
         virtual ~SMA();
 
+        virtual Module* clone() const {return new SMA(*this);};
+
         /** @brief Sets the window size in samples.*/
         void setWindowSize(int windowSize);
 
@@ -76,6 +78,8 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual void saveStateInternal(RealVec &state) const;
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
 
         int windowSize_, bufferIdx_;
         bool average_, squareInput_;
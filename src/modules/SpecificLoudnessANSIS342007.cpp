@@ -133,19 +133,20 @@ namespace loudness{
 
     void SpecificLoudnessANSIS342007::processInternal(const SignalBank &input)
     {
-        for (int src = 0; src < input.getNSources(); ++src)
+        processSlices(input.getNSources(), input.getNEars(),
+                [&](int src, int ear, int bufferIdx)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
+            const Real* inputExcitationPattern = input
+                                                 .getSingleSampleReadPointer
+                                                 (src, ear, 0);
+            Real* outputSpecificLoudness = output_
+                                           .getSingleSampleWritePointer
+                                           (src, ear, 0);
+
+            processChannels(input.getNChannels(), 128, [&](int begin, int end)
             {
                 Real excLin, sl = 0.0;
-                const Real* inputExcitationPattern = input
-                                                     .getSingleSampleReadPointer
-                                                     (src, ear, 0);
-                Real* outputSpecificLoudness = output_
-                                               .getSingleSampleWritePointer
-                                               (src, ear, 0);
-
-                for (int i = 0; i < input.getNChannels(); ++i)
+                for (int i = begin; i < end; ++i)
                 {
                     excLin = inputExcitationPattern[i];
 
@@ -184,12 +185,20 @@ namespace loudness{
                                 (pow(excLin+4.72096, 0.2)-1.3639739128330546);
                         }
                     }
-                    
+            
                     outputSpecificLoudness[i] = parameterC_ * sl;
                 }
-            }
-        }
+            });
+        });
     }
 
     void SpecificLoudnessANSIS342007::resetInternal(){};
+
+    void SpecificLoudnessANSIS342007::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {useANSISpecificLoudness_,
+            updateParameterCForBinauralInhibition_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(&parameterC_, sizeof(parameterC_), hash);
+    }
 }
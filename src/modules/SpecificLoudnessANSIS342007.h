@@ -83,12 +83,16 @@ namespace loudness{
 
         virtual ~SpecificLoudnessANSIS342007();
 
+        virtual Module* clone() const {return new SpecificLoudnessANSIS342007(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         bool useANSISpecificLoudness_, updateParameterCForBinauralInhibition_;
         int nFiltersLT500_;
@@ -84,6 +84,8 @@ namespace loudness{
 
         virtual ~SpecificLoudnessModANSIS342007();
 
+        virtual Module* clone() const {return new SpecificLoudnessModANSIS342007(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
@@ -32,12 +32,15 @@ namespace loudness{
 
         virtual ~SpecificPartialLoudnessCHGM2011();
 
+        virtual Module* clone() const {return new SpecificPartialLoudnessCHGM2011(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
 
         RealVec k_;
     };
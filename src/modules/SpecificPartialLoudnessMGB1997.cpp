@@ -266,4 +266,13 @@ namespace loudness{
     }
 
     void SpecificPartialLoudnessMGB1997::resetInternal(){};
+
+    void SpecificPartialLoudnessMGB1997::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {useANSISpecificLoudness_,
+            updateParameterCForBinauralInhibition_};
+        Real parameters[] = {parameterC_, parameterC2_, yearExp_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(parameters, sizeof(parameters), hash);
+    }
 }
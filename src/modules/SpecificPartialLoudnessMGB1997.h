@@ -92,12 +92,16 @@ namespace loudness{
 
         virtual ~SpecificPartialLoudnessMGB1997();
 
+        virtual Module* clone() const {return new SpecificPartialLoudnessMGB1997(*this);};
+
     private:
         virtual bool initializeInternal(const SignalBank &input);
         virtual bool initializeInternal(){return 0;};
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         bool useANSISpecificLoudness_, updateParameterCForBinauralInhibition_;
         Real parameterC_, parameterC2_, yearExp_;
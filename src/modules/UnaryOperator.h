@@ -38,6 +38,8 @@ namespace loudness{
 
         virtual ~UnaryOperator();
 
+        virtual Module* clone() const {return new UnaryOperator(*this);};
+
     private:
 
         virtual bool initializeInternal(const SignalBank &input);
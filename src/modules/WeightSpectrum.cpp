@@ -55,27 +55,36 @@ namespace loudness{
         output_.initialize(input);
 
         //convert to linear power units for weighting power spectrum
+        RealVec linearWeights(output_.getNChannels());
         for (int chn = 0; chn < output_.getNChannels(); chn++)
-            weights_[chn] = pow(10, weights_[chn]/10.0);
+            linearWeights[chn] = pow(10, weights_[chn]/10.0);
+        linearWeights_ = TableRegistry::share(linearWeights);
 
         return 1;
     }
 
     void WeightSpectrum::processInternal(const SignalBank &input)
     {
+        int nEars = getNEarsToProcess(input);
+        const RealVec& weights = *linearWeights_;
+        int begin = input.getChangedChannelsBegin();
+        int end = input.getChangedChannelsEnd();
         for (int src = 0; src < input.getNSources(); ++src)
         {
-            for (int ear = 0; ear < input.getNEars(); ++ear)
+            for (int ear = 0; ear < nEars; ++ear)
             {
                 const Real* inputSpectrum = input.getSingleSampleReadPointer
                                             (src, ear, 0);
                 Real* outputSpectrum = output_.getSingleSampleWritePointer
                                        (src, ear, 0);
 
-                for (int chn = 0; chn < input.getNChannels(); ++chn)
-                    outputSpectrum[chn] = inputSpectrum[chn] * weights_[chn];
+                for (int chn = begin; chn < end; ++chn)
+                    outputSpectrum[chn] = inputSpectrum[chn] * weights[chn];
             }
         }
+
+        output_.setChangedChannels(begin, end);
+        mirrorEars();
     }
 
     void WeightSpectrum::setWeights(const RealVec &weights)
@@ -84,4 +93,21 @@ namespace loudness{
     }
 
     void WeightSpectrum::resetInternal(){};
+
+    bool WeightSpectrum::isEquivalentTo(const Module& other) const
+    {
+        const WeightSpectrum* that = dynamic_cast<const WeightSpectrum*>(&other);
+        if (!that || usingOME_ != that -> usingOME_)
+            return false;
+        if (usingOME_)
+            return ome_.getMiddleEarType() == that -> ome_.getMiddleEarType() &&
+                   ome_.getOuterEarType() == that -> ome_.getOuterEarType();
+        return weights_ == that -> weights_;
+    }
+
+    void WeightSpectrum::hashConfiguration(unsigned long long& hash) const
+    {
+        //the weights are interpolated from the OME filters on initialisation
+        hashBytes(weights_.data(), weights_.size() * sizeof(Real), hash);
+    }
 }
@@ -22,6 +22,7 @@
 
 #include "../support/Module.h"
 #include "../support/AuditoryTools.h"
+#include "../support/TableRegistry.h"
 
 namespace loudness{
 
@@ -58,6 +59,8 @@ namespace loudness{
 
         virtual ~WeightSpectrum();
 
+        virtual Module* clone() const {return new WeightSpectrum(*this);};
+
         /**
          * @brief Set the vector of weights (in decibels).
          */
@@ -69,8 +72,12 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         RealVec weights_;
+        std::shared_ptr<const RealVec> linearWeights_;
         OME ome_;
         bool usingOME_;
     };
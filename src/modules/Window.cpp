@@ -117,13 +117,14 @@ namespace loudness{
 
     void Window::processInternal(const SignalBank &input)
     {
+        int nEars = getNEarsToProcess(input);
         switch (method_)
         {
             case ONE_CHANNEL_MULTI_WINDOW:
             {
                 for (int src = 0; src < input.getNSources(); ++src)
                 {
-                    for(int ear = 0; ear < input.getNEars(); ++ear)
+                    for(int ear = 0; ear < nEars; ++ear)
                     {
                         for(int w = 0; w < nWindows_; ++w)
                         {
@@ -153,7 +154,7 @@ namespace loudness{
             {
                 for (int src = 0; src < input.getNSources(); ++src)
                 {
-                    for (int ear = 0; ear < input.getNEars(); ++ear)
+                    for (int ear = 0; ear < nEars; ++ear)
                     {
                         for (int chn = 0; chn < input.getNChannels(); ++chn)
                         {
@@ -180,6 +181,8 @@ namespace loudness{
                 }
             }
         }
+
+        mirrorEars();
     }
 
     void Window::resetInternal()
@@ -254,4 +257,20 @@ namespace loudness{
         }
     }
 
+    bool Window::isEquivalentTo(const Module& other) const
+    {
+        const Window* that = dynamic_cast<const Window*>(&other);
+        return that &&
+               windowType_ == that -> windowType_ &&
+               length_ == that -> length_ &&
+               periodic_ == that -> periodic_ &&
+               normalisation_ == that -> normalisation_;
+    }
+
+    void Window::hashConfiguration(unsigned long long& hash) const
+    {
+        int config[] = {windowType_, periodic_, normalisation_};
+        hashBytes(config, sizeof(config), hash);
+        hashBytes(length_.data(), length_.size() * sizeof(int), hash);
+    }
 }
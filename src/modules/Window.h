@@ -78,6 +78,8 @@ namespace loudness{
         Window();
         virtual ~Window();
 
+        virtual Module* clone() const {return new Window(*this);};
+
         /**
          * @brief Normalises the window, typically for FFT usage.
          *
@@ -107,6 +109,9 @@ namespace loudness{
         virtual void processInternal(const SignalBank &input);
         virtual void processInternal(){};
         virtual void resetInternal();
+        virtual bool isStateless() const {return true;};
+        virtual bool isEquivalentTo(const Module& other) const;
+        virtual void hashConfiguration(unsigned long long& hash) const;
 
         //window functions
         void hann(RealVec &window, bool periodic);
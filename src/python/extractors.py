@@ -62,11 +62,67 @@ class StationaryLoudnessExtractor:
         for name in self.outputs:
             outputBank = self.model.getOutput(name)
             self.outputDict[name] = (
-                np.squeeze(outputBank.getSignals())
+                np.squeeze(outputBank.getSignalsView())
             ).copy()
 
         self.model.reset()
 
+    def processBatch(self, frequencies, intensityLevels, nThreads=0):
+        '''
+        Processes many spectra in parallel, initialising the model once per
+        frequency grid rather than once per spectrum.
+
+        intensityLevels is an array of shape (nSpectra, nComponents) or
+        (nSpectra, nComponents, nEars) of levels at the given frequencies.
+        To mix grids, pass lists of frequencies and intensityLevels. Returns
+        a dictionary mapping each output name to an array with one row per
+        spectrum, or a list of dictionaries if lists were passed.
+        '''
+
+        isList = type(frequencies) is list
+        if not isList:
+            frequencies = [frequencies]
+            intensityLevels = [intensityLevels]
+        if len(frequencies) != len(intensityLevels):
+            raise ValueError("Must have one set of levels per grid")
+
+        batch = ln.StationaryBatchProcessor()
+        batch.setOutputs(self.outputs)
+        batch.setNThreads(nThreads)
+        for freqs, levels in zip(frequencies, intensityLevels):
+            levels = np.asarray(levels, dtype=float)
+            if levels.ndim == 2:
+                levels = levels[:, :, np.newaxis]
+            if levels.ndim != 3 or levels.shape[1] != freqs.size:
+                raise ValueError(
+                    "Number of component intensities does not match" +
+                    " number of component frequencies"
+                )
+            intensities = 10**(levels.transpose((0, 2, 1)) / 10.0)
+            batch.addSpectra(np.ascontiguousarray(intensities),
+                             np.asarray(freqs, dtype=float))
+
+        batch.process(self.model)
+
+        outputDicts = []
+        for group, freqs in enumerate(frequencies):
+            if not batch.isGroupProcessed(group):
+                raise ValueError("Model cannot process grid %d" % group)
+            outputDict = {'Frequencies': freqs}
+            nSpectra = batch.getNSpectra(group)
+            for name in self.outputs:
+                bank = batch.getOutput(group, name)
+                if not bank.isInitialized():
+                    raise ValueError("%s is not a model output" % name)
+                outputs = bank.getAggregatedSignals()
+                outputDict[name] = np.squeeze(
+                    outputs.reshape((nSpectra, -1))).copy()
+            outputDicts.append(outputDict)
+
+        if isList:
+            return outputDicts
+        return outputDicts[0]
+
 
 class DynamicLoudnessExtractor:
     '''Convienience class for processing numpy arrays.
@@ -148,7 +204,7 @@ class DynamicLoudnessExtractor:
         self.loudness = None
         self.globalLoudness = None
 
-    def configureInput(self, inputSignal):
+    def shapeInput(self, inputSignal):
 
         if not isinstance(inputSignal, list):
             if inputSignal.ndim == 1:
@@ -170,6 +226,11 @@ class DynamicLoudnessExtractor:
             for i, isig in enumerate(inputSignal):
                 sig[i, :, 0, :isig.shape[0]] = isig.T
 
+        return sig
+
+    def configureInput(self, inputSignal):
+
+        sig = self.shapeInput(inputSignal)
         sig = np.concatenate((
             np.zeros((self.nInputSources, self.nInputEars,
                       1, self.nSamplesToPadStart)),
@@ -221,51 +282,33 @@ class DynamicLoudnessExtractor:
 
             # Store
             for bank, dataset in zip(outputBanks, datasets):
-                dataset[frame] = bank.getSignals()
+                dataset[frame] = bank.getSignalsView()
 
         # Processing complete so clear internal states
         self.model.reset()
         self.processed = True
 
-    def outputToDictionary(self, inputSignal, nOutputFrames):
+    def outputToDictionary(self, inputSignal):
 
-        dic = {'FrameTime':
-               self.frameTimeOffset + np.arange(nOutputFrames) *
-               self.hopSize / float(self.fs),
-        }
+        # The whole signal, including padding, is processed by a single call
+        dic = self.model.processSignalArray(inputSignal[:, :, 0, :],
+                                            self.outputs,
+                                            self.nSamplesToPadStart,
+                                            self.nSamplesToPadEnd)
+        if dic is None:
+            raise ValueError("Problem processing the input signal!")
 
-        outputBanks = []
+        nOutputFrames = 0
         for name in self.outputs:
-            bank = self.model.getOutput(name)
-            outputBanks.append(bank)
-            shape = (
-                nOutputFrames,
-                bank.getNSources(),
-                bank.getNEars(),
-                bank.getNChannels(),
-                bank.getNSamples(),
-            )
-            dic[name] = np.squeeze(np.zeros(shape=shape))
-
-        # One process call every hop samples
-        for frame in range(nOutputFrames):
-
-            startIdx = frame * self.hopSize
-            endIdx = startIdx + self.hopSize
-            self.inputBuf.setSignals(
-                inputSignal[:, :, :, startIdx:endIdx]
-            )
+            nOutputFrames = dic[name].shape[0]
+            dic[name] = np.squeeze(dic[name])
 
-            # Process the input buffer
-            self.model.process(self.inputBuf)
-
-            # Store
-            for bank, name in zip(outputBanks, self.outputs):
-                dic[name][frame] = np.squeeze(bank.getSignals())
+        dic['FrameTime'] = (self.frameTimeOffset +
+                            np.arange(nOutputFrames) *
+                            self.hopSize / float(self.fs))
 
         return dic
 
-
     def process(self, inputSignal, hdf5Group=None):
         '''
         Process the numpy array `inputSignal' using a dynamic loudness
@@ -277,8 +320,8 @@ class DynamicLoudnessExtractor:
         '''
 
         if hdf5Group is None:
-            sig, nOutputFrames = self.configureInput(inputSignal)
-            dic = self.outputToDictionary(sig, nOutputFrames)
+            sig = self.shapeInput(inputSignal)
+            dic = self.outputToDictionary(sig)
         elif isinstance(hdf5Group, h5py.Group):
             sig, nOutputFrames = self.configureInput(inputSignal)
             self.outputToHDF5(sig, nOutputFrames, hdf5Group)
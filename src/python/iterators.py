@@ -1,6 +1,7 @@
 import os
 import numpy as np
 import matplotlib.pyplot as plt
+import loudness as ln
 from .sound import Sound
 from .extractors import DynamicLoudnessExtractor, StationaryLoudnessExtractor
 
@@ -101,6 +102,12 @@ class DynamicLoudnessIterator():
 
 
 class StationaryLoudnessIterator():
+    '''
+    Finds the gain applied to a whole spectrum giving a target loudness by
+    fixed-step iteration. StationaryLevelSolver solves the level of a
+    single component and is not used here; see the solve() methods of the
+    stationary predictors.
+    '''
 
     def __init__(self,
                  model,
@@ -434,6 +441,32 @@ class StationaryLoudnessISOThresholdPredictor():
                                                          levels,
                                                          None)
 
+    def solve(self, nThreads=0, tol=0.001):
+        '''
+        As process(), but using the native StationaryLevelSolver on a grid
+        holding one frequency at a time, solving all frequencies in
+        parallel. The target is the loudness of a 1 kHz component at the
+        threshold level, i.e. the threshold in phons. tol is in dB.
+        '''
+        outputName = self.iterator.outputName
+        extractor = StationaryLoudnessExtractor(
+            self.iterator.extractor.model, outputName)
+        extractor.process(np.array([1000.0]), np.array([self.threshold]))
+        targetLoudness = float(np.squeeze(extractor.outputDict[outputName]))
+
+        solver = ln.StationaryLevelSolver(outputName)
+        solver.setFrequencies(self.freqsISO)
+        solver.setComponentsSolvedAlone(True)
+        solver.setTolerance(tol)
+        solver.setNThreads(nThreads)
+        for i in range(self.freqsISO.size):
+            solver.addTarget(i, targetLoudness)
+        solver.solve(extractor.model)
+
+        self.predictions = np.array(solver.getLevels())
+        self.converged = np.array(
+            [solver.isConverged(i) for i in range(self.freqsISO.size)])
+
     def plotPredictions(self):
 
         plt.semilogx(
@@ -1,5 +1,6 @@
 import numpy as np
 import matplotlib.pyplot as plt
+import loudness as ln
 from .sound import Sound
 from .iterators import StationaryLoudnessIterator, DynamicLoudnessIterator
 from .extractors import StationaryLoudnessExtractor, DynamicLoudnessExtractor
@@ -80,6 +81,33 @@ class StationaryLoudnessContourPredictor():
             )
             self.converged[i] = self.iterator.converged
 
+    def solve(self, nThreads=0, tol=0.001):
+        '''
+        As process(), but using the native StationaryLevelSolver, which
+        brackets each level and refines it with Brent's method, solving all
+        frequencies in parallel. Each frequency is solved on a grid holding
+        that component alone. The model output must be a single loudness
+        value; loudnessLevelFunction is not needed because matching loudness
+        also matches any monotonic function of it. tol is in dB.
+        '''
+        self.extractor.process(np.array([1000.0]),
+                               np.array([self.loudnessLevel]))
+        targetLoudness = float(
+            np.squeeze(self.extractor.outputDict[self.outputName]))
+
+        solver = ln.StationaryLevelSolver(self.outputName)
+        solver.setFrequencies(self.freqs)
+        solver.setComponentsSolvedAlone(True)
+        solver.setTolerance(tol)
+        solver.setNThreads(nThreads)
+        for i in range(self.freqs.size):
+            solver.addTarget(i, targetLoudness)
+        solver.solve(self.extractor.model)
+
+        self.predictions = np.array(solver.getLevels())
+        self.converged = np.array(
+            [solver.isConverged(i) for i in range(self.freqs.size)])
+
     def plotPredictions(self):
 
         plt.semilogx(self.freqs, self.sPLs, label='ISO target')
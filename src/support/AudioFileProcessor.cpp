@@ -18,12 +18,20 @@
  */
 
 #include "AudioFileProcessor.h"
+#include "ThreadPool.h"
 
 namespace loudness{
 
     AudioFileProcessor::AudioFileProcessor(const string& fileName) :
+        fileName_(fileName),
         cutter_(fileName),
-        gainInDecibels_(0)
+        gainInDecibels_(0),
+        segmentWarmUpDuration_(10.0),
+        seamCheckDuration_(0.5),
+        maxSeamDeviation_(0.0),
+        maxSequentialDeviation_(0.0),
+        nThreads_(0),
+        isSequentialReferenceUsed_(false)
     {
         LOUDNESS_DEBUG("AudioFileProcessor: Constructed");
     }
@@ -67,13 +75,195 @@ namespace loudness{
             cutter_.process();
             model.process(cutter_.getOutput());
         }
+        model.synchronize();
         cutter_.reset();
     }
 
+    void AudioFileProcessor::processAllFramesInSegments(Model& model,
+            int nSegments)
+    {
+        maxSeamDeviation_ = 0.0;
+        maxSequentialDeviation_ = 0.0;
+        nSegments = min(nSegments, nFrames_);
+        if (nSegments < 2)
+        {
+            processAllFrames(model);
+            return;
+        }
+
+        //one model per thread, the segments are shared between them
+        int nThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+        if (nThreads_ > 0)
+            nThreads = min(nThreads_, nThreads);
+        int nModels = min(nThreads, nSegments);
+        vector<Model*> idleModels {&model};
+        vector<unique_ptr<Model>> clones;
+        for (int k = 1; k < nModels; ++k)
+        {
+            clones.push_back(unique_ptr<Model> (model.clone()));
+            if (!clones.back())
+            {
+                LOUDNESS_WARNING("AudioFileProcessor: Model cannot be cloned, "
+                        << "processing sequentially.");
+                processAllFrames(model);
+                return;
+            }
+            idleModels.push_back(clones.back().get());
+        }
+
+        //the reference processes all hops, so it goes first
+        unique_ptr<Model> reference;
+        if (isSequentialReferenceUsed_)
+        {
+            reference.reset(model.clone());
+            if (!reference)
+                LOUDNESS_WARNING("AudioFileProcessor: Model cannot be cloned, "
+                        << "no sequential reference.");
+        }
+
+        int nWarmUpFrames = (int)round(segmentWarmUpDuration_ / timeStep_);
+        int nCheckFrames = max((int)round(seamCheckDuration_ / timeStep_), 1);
+        vector<int> start(nSegments + 1), first(nSegments), last(nSegments);
+        for (int k = 0; k <= nSegments; ++k)
+            start[k] = (int)(((long long)k * nFrames_) / nSegments);
+        for (int k = 0; k < nSegments; ++k)
+        {
+            first[k] = max(start[k] - nWarmUpFrames, 0);
+            last[k] = min(start[k + 1] + nCheckFrames, nFrames_);
+        }
+
+        //segment k covers hops [first, last) of the aggregated outputs
+        vector<string> outputNames = model.getAggregatedOutputNames();
+        vector<vector<RealVec>> segmentOutputs(nSegments,
+                vector<RealVec>(outputNames.size()));
+        std::mutex idleModelsMutex;
+        int nReferenceTasks = reference ? 1 : 0;
+        int nTasks = nSegments + nReferenceTasks;
+        ThreadPool threadPool(min(nThreads, nTasks));
+        threadPool.parallelFor(nTasks, [&](int i)
+        {
+            int k = i - nReferenceTasks;
+            bool isReference = k < 0;
+            Model* segmentModel = reference.get();
+            if (!isReference)
+            {
+                std::lock_guard<std::mutex> lock(idleModelsMutex);
+                segmentModel = idleModels.back();
+                idleModels.pop_back();
+            }
+            int firstFrame = isReference ? 0 : first[k];
+            int lastFrame = isReference ? nFrames_ : last[k];
+
+            AudioFileCutter cutter(fileName_, cutter_.getFrameSize());
+            cutter.setGainInDecibels(gainInDecibels_);
+            cutter.initialize();
+            cutter.seekFrame(firstFrame);
+
+            segmentModel -> reset();
+            for (int frame = firstFrame; frame < lastFrame; ++frame)
+            {
+                cutter.process();
+                segmentModel -> process(cutter.getOutput());
+            }
+            segmentModel -> synchronize();
+
+            if (!isReference)
+            {
+                for (uint j = 0; j < outputNames.size(); ++j)
+                {
+                    segmentOutputs[k][j] = segmentModel
+                        -> getOutput(outputNames[j]).getAggregatedSignals();
+                }
+                std::lock_guard<std::mutex> lock(idleModelsMutex);
+                idleModels.push_back(segmentModel);
+            }
+        });
+
+        //stitch, and compare the overlap of adjacent segments
+        for (uint j = 0; j < outputNames.size(); ++j)
+        {
+            const string& outputName = outputNames[j];
+            int blockSize = model.getOutput(outputName).getNTotalSamples();
+            RealVec stitched;
+            stitched.reserve((long long)nFrames_ * blockSize);
+            for (int k = 0; k < nSegments; ++k)
+            {
+                const RealVec& signals = segmentOutputs[k][j];
+                auto begin = signals.begin()
+                    + (long long)(start[k] - first[k]) * blockSize;
+                stitched.insert(stitched.end(), begin,
+                        begin + (long long)(start[k + 1] - start[k]) * blockSize);
+
+                if (k > 0)
+                {
+                    const RealVec& previous = segmentOutputs[k - 1][j];
+                    auto previousBegin = previous.begin()
+                        + (long long)(start[k] - first[k - 1]) * blockSize;
+                    int nSamples = (min(start[k] + nCheckFrames, start[k + 1])
+                            - start[k]) * blockSize;
+                    for (int i = 0; i < nSamples; ++i)
+                    {
+                        maxSeamDeviation_ = max(maxSeamDeviation_,
+                                std::abs(previousBegin[i] - begin[i]));
+                    }
+                }
+            }
+
+            if (reference)
+            {
+                const RealVec& sequential = reference
+                    -> getOutput(outputName).getAggregatedSignals();
+                uint nSamples = std::min(stitched.size(), sequential.size());
+                for (uint i = 0; i < nSamples; ++i)
+                {
+                    maxSequentialDeviation_ = max(maxSequentialDeviation_,
+                            std::abs(stitched[i] - sequential[i]));
+                }
+            }
+            model.setAggregatedOutput(outputName, stitched);
+        }
+
+        LOUDNESS_DEBUG("AudioFileProcessor: Maximum seam deviation: "
+                << maxSeamDeviation_);
+    }
+
+    void AudioFileProcessor::setSegmentWarmUpDuration(
+            Real segmentWarmUpDuration)
+    {
+        segmentWarmUpDuration_ = max(segmentWarmUpDuration, 0.0);
+    }
+
+    void AudioFileProcessor::setSeamCheckDuration(Real seamCheckDuration)
+    {
+        seamCheckDuration_ = seamCheckDuration;
+    }
+
+    Real AudioFileProcessor::getMaxSeamDeviation() const
+    {
+        return maxSeamDeviation_;
+    }
+
+    void AudioFileProcessor::setSequentialReferenceUsed(
+            bool isSequentialReferenceUsed)
+    {
+        isSequentialReferenceUsed_ = isSequentialReferenceUsed;
+    }
+
+    Real AudioFileProcessor::getMaxSequentialDeviation() const
+    {
+        return maxSequentialDeviation_;
+    }
+
+    void AudioFileProcessor::setNThreads(int nThreads)
+    {
+        nThreads_ = nThreads;
+    }
+
     void AudioFileProcessor::loadNewAudioFile(const string& fileName)
     {
         if (cutter_.isInitialized())
         {
+            fileName_ = fileName;
             cutter_.setFileName(fileName);
             cutter_.setGainInDecibels(gainInDecibels_);
             cutter_.initialize();
@@ -46,6 +46,19 @@ namespace loudness{
      * desired. This class will take care of object initialisation upon calling
      * initialize().
      *
+     * Long files can be split into segments processed in parallel with
+     * processAllFramesInSegments(). Each thread processes segments with its
+     * own copy of the model, which first runs over a warm-up pre-roll so that
+     * the filters and temporal integrators carry approximately the right
+     * state at the start of the segment. The aggregated outputs of the
+     * segments are then stitched into the input model. The result differs
+     * from processAllFrames() only near the segment seams.
+     * getMaxSeamDeviation() estimates the deviation there by comparing
+     * adjacent segments over their overlap. For the actual deviation from
+     * sequential processing, enable setSequentialReferenceUsed(), which also
+     * processes the whole file sequentially and reports the result from
+     * getMaxSequentialDeviation().
+     *
      */
     class AudioFileProcessor
     {
@@ -72,9 +85,57 @@ namespace loudness{
 
         /** Processes all frames of the audio file.
          * This function will call model.reset() before
-         * processing the audio file, but not after. */
+         * processing the audio file, but not after. If the model is
+         * pipelined, it is synchronised before returning. */
         void processAllFrames(Model& model);
 
+        /**
+         * @brief Processes all frames of the audio file in nSegments
+         * consecutive segments, shared between the threads set by
+         * setNThreads().
+         *
+         * The model must have been initialised with initialize() and
+         * should aggregate the outputs of interest; only aggregated outputs
+         * are stitched together. Each thread processes its segments with
+         * the model or one of its clones (see Model::clone()), starting the
+         * warm-up duration before the segment. Each segment also continues
+         * over the seam check duration after its end, which is compared with
+         * the start of the following segment to measure the seam deviation.
+         * If the model cannot be cloned, all frames are processed
+         * sequentially.
+         */
+        void processAllFramesInSegments(Model& model, int nSegments);
+
+        /** Sets the duration of the pre-roll, in seconds, processed and
+         * discarded before each segment (default 10 s). */
+        void setSegmentWarmUpDuration(Real segmentWarmUpDuration);
+
+        /** Sets the duration, in seconds, after each seam over which
+         * segment outputs are checked (default 0.5 s). */
+        void setSeamCheckDuration(Real seamCheckDuration);
+
+        /** Returns the maximum absolute difference between the aggregated
+         * outputs of adjacent segments over the seam check durations of the
+         * last call to processAllFramesInSegments(). Both segments are
+         * approximations, so this is an estimate of the deviation from
+         * sequential processing. */
+        Real getMaxSeamDeviation() const;
+
+        /** Set to true to let processAllFramesInSegments() also process the
+         * whole file sequentially, on a further clone of the model, as a
+         * reference for the stitched outputs (default false). */
+        void setSequentialReferenceUsed(bool isSequentialReferenceUsed);
+
+        /** Sets the number of threads used by processAllFramesInSegments()
+         * (default 0, meaning the number of hardware threads). At most the
+         * number of hardware threads is used. */
+        void setNThreads(int nThreads);
+
+        /** Returns the maximum absolute difference between the stitched and
+         * the sequentially processed aggregated outputs of the last call to
+         * processAllFramesInSegments(), or zero if no reference was used. */
+        Real getMaxSequentialDeviation() const;
+
         /** Set the gain in decibels to be applied to the audio file. */
         void setGainInDecibels(Real gainInDecibels);
 
@@ -95,6 +156,10 @@ namespace loudness{
         int nFrames_, hopSize_;
         AudioFileCutter cutter_;
         Real timeStep_, gainInDecibels_;
+        Real segmentWarmUpDuration_, seamCheckDuration_, maxSeamDeviation_;
+        Real maxSequentialDeviation_;
+        int nThreads_;
+        bool isSequentialReferenceUsed_;
         vector<string> modelOutputsToSave_;
     };
 }
@@ -351,6 +351,16 @@ namespace loudness{
         }
     }
 
+    OME::Filter OME::getMiddleEarType() const
+    {
+        return middleEarType_;
+    }
+
+    OME::Filter OME::getOuterEarType() const
+    {
+        return outerEarType_;
+    }
+
     const RealVec& OME::getResponse() const
     {
         return response_;
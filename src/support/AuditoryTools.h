@@ -233,6 +233,8 @@ namespace loudness{
 
             void setMiddleEarType(const Filter& middleEarType);
             void setOuterEarType(const Filter& outerEarType);
+            Filter getMiddleEarType() const;
+            Filter getOuterEarType() const;
             bool interpolateResponse(const RealVec &freqs);
             const RealVec& getResponse() const;
             const RealVec& getMiddleEardB() const;
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "BatchProcessor.h"
+#include "ThreadPool.h"
+#include "../modules/AudioFileCutter.h"
+#include <atomic>
+#include <numeric>
+
+namespace loudness{
+
+    BatchProcessor::BatchProcessor() :
+        nThreads_(0),
+        gainInDecibels_(0.0),
+        sink_(nullptr)
+    {
+        LOUDNESS_DEBUG("BatchProcessor: Constructed");
+    }
+
+    BatchProcessor::~BatchProcessor() {};
+
+    void BatchProcessor::addFile(const string& fileName)
+    {
+        Item item;
+        item.fileName = fileName;
+        item.nChannels = 0;
+        item.fs = 0;
+        item.nFrames = 0;
+        item.duration = 0.0;
+        item.isProcessed = false;
+        items_.push_back(item);
+    }
+
+    void BatchProcessor::addBuffer(Real* data, int nSamples, int nChannels,
+            int fs)
+    {
+        LOUDNESS_ASSERT((nChannels > 0) && (fs > 0) &&
+                (nSamples % nChannels == 0), "Invalid buffer specification.");
+
+        Item item;
+        item.data.assign(data, data + nSamples);
+        item.nChannels = nChannels;
+        item.fs = fs;
+        item.nFrames = 0;
+        item.duration = nSamples / (Real)(nChannels * fs);
+        item.isProcessed = false;
+        items_.push_back(item);
+    }
+
+    void BatchProcessor::clear()
+    {
+        items_.clear();
+    }
+
+    int BatchProcessor::process(const Model& prototype)
+    {
+        LOUDNESS_ASSERT(prototype.isDynamic(), "Model is not dynamic.");
+
+        //durations from the file headers, for longest first scheduling
+        for (auto &item : items_)
+        {
+            if (item.fileName.empty())
+                continue;
+
+            SF_INFO fileInfo;
+            fileInfo.format = 0;
+            SNDFILE* sndFile = sf_open(item.fileName.c_str(), SFM_READ,
+                    &fileInfo);
+            if (sndFile)
+            {
+                item.duration = fileInfo.frames / (Real)fileInfo.samplerate;
+                sf_close(sndFile);
+            }
+        }
+
+        vector<int> order(items_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                [this](int a, int b){
+                    return items_[a].duration > items_[b].duration;});
+
+        std::atomic<int> nProcessed(0);
+        ThreadPool threadPool(nThreads_);
+        threadPool.parallelFor((int)order.size(), [&](int i)
+        {
+            Item& item = items_[order[i]];
+            item.outputs.clear();
+            item.isProcessed = processItem(prototype, item, order[i]);
+            if (item.isProcessed)
+                nProcessed++;
+            else
+                LOUDNESS_WARNING("BatchProcessor: Item " << order[i]
+                        << " not processed.");
+        });
+
+        idleModels_.clear();
+        specModels_.clear();
+
+        LOUDNESS_DEBUG("BatchProcessor: " << nProcessed << " of "
+                << items_.size() << " items processed.");
+
+        return nProcessed;
+    }
+
+    bool BatchProcessor::processItem(const Model& prototype, Item& item,
+            int itemIdx)
+    {
+        //input frames are read from the file or cut from the buffer
+        SignalBank input;
+        unique_ptr<AudioFileCutter> cutter;
+        int frameSize = 0;
+        if (!item.fileName.empty())
+        {
+            cutter.reset(new AudioFileCutter(item.fileName));
+            cutter -> setFrameSizeInSeconds(1.0 / prototype.getRate());
+            cutter -> setGainInDecibels(gainInDecibels_);
+            if (!cutter -> initialize())
+                return 0;
+            input.initialize(cutter -> getOutput());
+            item.nFrames = cutter -> getNFrames();
+        }
+        else
+        {
+            frameSize = (int)round(item.fs / prototype.getRate());
+            input.initialize(1, item.nChannels, 1, frameSize, item.fs);
+            int nSamplesPerChannel = item.data.size() / item.nChannels;
+            item.nFrames = ceil(nSamplesPerChannel / (Real)frameSize);
+        }
+
+        unique_ptr<Model> model = acquireModel(prototype, input);
+        if (!model)
+            return 0;
+
+        model -> reset();
+        Real linearGain = decibelsToAmplitude(gainInDecibels_);
+        int nEars = item.nChannels;
+        for (int frame = 0; frame < item.nFrames; ++frame)
+        {
+            if (cutter)
+            {
+                cutter -> process();
+                model -> process(cutter -> getOutput());
+            }
+            else
+            {
+                input.zeroSignals();
+                int start = frame * frameSize * nEars;
+                int nSamples = min(frameSize,
+                        (int)(item.data.size() - start) / nEars);
+                for (int ear = 0; ear < nEars; ++ear)
+                {
+                    const Real* inputSignal = &item.data[start + ear];
+                    Real* outputSignal = input.getSignalWritePointer(0, ear, 0, 0);
+                    for (int smp = 0; smp < nSamples; ++smp)
+                    {
+                        *outputSignal++ = *inputSignal;
+                        inputSignal += nEars;
+                    }
+                }
+                input.scale(linearGain);
+                model -> process(input);
+            }
+        }
+        model -> synchronize();
+
+        if (sink_)
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex_);
+            sink_ -> consume(itemIdx, *model);
+        }
+        else
+        {
+            for (const auto &outputName : model -> getAggregatedOutputNames())
+                item.outputs[outputName] = model -> getOutput(outputName)
+                                           .getAggregatedSignals();
+        }
+
+        releaseModel(input, std::move(model));
+
+        return 1;
+    }
+
+    unique_ptr<Model> BatchProcessor::acquireModel(const Model& prototype,
+            const SignalBank& input)
+    {
+        std::lock_guard<std::mutex> lock(modelMutex_);
+        auto spec = std::make_pair(input.getFs(), input.getNEars());
+        auto& idle = idleModels_[spec];
+        if (!idle.empty())
+        {
+            unique_ptr<Model> model = std::move(idle.back());
+            idle.pop_back();
+            return model;
+        }
+
+        //one model is initialised per specification and copied from then on
+        unique_ptr<Model>& specModel = specModels_[spec];
+        if (!specModel)
+        {
+            specModel.reset(prototype.clone());
+            if (!specModel)
+            {
+                LOUDNESS_ERROR("BatchProcessor: Model cannot be cloned.");
+                return nullptr;
+            }
+
+            specModel -> setParallelBranchesUsed(false);
+            specModel -> setParallelSlicesUsed(false);
+            specModel -> setParallelChannelsUsed(false);
+            specModel -> setPipelineUsed(false);
+            specModel -> setFrameParallelUsed(false);
+            if (!specModel -> initialize(input))
+            {
+                specModel.reset();
+                return nullptr;
+            }
+        }
+
+        //all clones of this specification are busy, so there is at most one
+        //clone per thread in addition to the specification model
+        return unique_ptr<Model> (specModel -> clone());
+    }
+
+    void BatchProcessor::releaseModel(const SignalBank& input,
+            unique_ptr<Model> model)
+    {
+        std::lock_guard<std::mutex> lock(modelMutex_);
+        idleModels_[std::make_pair(input.getFs(), input.getNEars())]
+            .push_back(std::move(model));
+    }
+
+    void BatchProcessor::setSink(BatchSink* sink)
+    {
+        sink_ = sink;
+    }
+
+    void BatchProcessor::setNThreads(int nThreads)
+    {
+        nThreads_ = nThreads;
+    }
+
+    void BatchProcessor::setGainInDecibels(Real gainInDecibels)
+    {
+        gainInDecibels_ = gainInDecibels;
+    }
+
+    int BatchProcessor::getNItems() const
+    {
+        return (int)items_.size();
+    }
+
+    const string& BatchProcessor::getItemName(int item) const
+    {
+        return items_[item].fileName;
+    }
+
+    bool BatchProcessor::isItemProcessed(int item) const
+    {
+        return items_[item].isProcessed;
+    }
+
+    int BatchProcessor::getNFrames(int item) const
+    {
+        return items_[item].nFrames;
+    }
+
+    const RealVec& BatchProcessor::getAggregatedOutput(int item,
+            const string& outputName) const
+    {
+        auto search = items_[item].outputs.find(outputName);
+        if (search == items_[item].outputs.end())
+            return emptyOutput_;
+        return search -> second;
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include "Common.h"
+#include "Model.h"
+#include <mutex>
+
+namespace loudness{
+
+    /**
+     * @class BatchSink
+     *
+     * @brief Receives the results of a BatchProcessor as each item completes.
+     *
+     * consume() is called from the worker thread that processed the item,
+     * but never concurrently, so implementations need no locking. Items
+     * complete in no particular order.
+     */
+    class BatchSink
+    {
+    public:
+        virtual ~BatchSink() {};
+
+        /**
+         * @brief Called once per item.
+         *
+         * @param item Index of the item in the order items were added.
+         * @param model The model that processed the item. Its aggregated
+         * outputs hold the results, but are only valid during this call.
+         */
+        virtual void consume(int item, const Model& model) = 0;
+    };
+
+    /**
+     * @class BatchProcessor
+     *
+     * @brief Processes many audio files or in-memory signals in parallel
+     * with a loudness model.
+     *
+     * Items are processed on a ThreadPool, each by a single model from
+     * start to end. Models are clones (see Model::clone()) of a configured
+     * prototype, one per thread and input specification (sampling
+     * frequency, number of channels), so files with different sampling
+     * frequencies can be mixed. Only the first model for each specification
+     * is initialised; the others are copied from it with Model::clone(). A
+     * clone is reset before each item, which makes the results identical to
+     * processing the items one at a time with
+     * AudioFileProcessor::processAllFrames().
+     *
+     * Items are scheduled longest first, so that the last items to
+     * complete are short ones. Results are the aggregated outputs of the
+     * prototype (see Model::setOutputsToAggregate()). They are passed to
+     * a BatchSink as each item completes or, if no sink is set, kept and
+     * accessed with getAggregatedOutput() after process() returns.
+     *
+     * Parallelism is across items only: the parallel options of the
+     * prototype (branches, slices, pipeline etc.) are turned off in the
+     * clones.
+     */
+    class BatchProcessor
+    {
+    public:
+
+        BatchProcessor();
+        ~BatchProcessor();
+
+        /** Adds an audio file to the batch. */
+        void addFile(const string& fileName);
+
+        /** Adds a signal held in memory to the batch. Multichannel signals
+         * are interleaved, as in an audio file. */
+        void addBuffer(Real* data, int nSamples, int nChannels, int fs);
+
+        /** Removes all items and results. */
+        void clear();
+
+        /**
+         * @brief Processes all items with clones of prototype.
+         *
+         * The prototype is not initialised or modified. Returns the number
+         * of items processed successfully.
+         */
+        int process(const Model& prototype);
+
+        /** Sets the sink receiving results. The sink must outlive calls to
+         * process(). Set to nullptr to keep the results instead. */
+        void setSink(BatchSink* sink);
+
+        /** Sets the number of threads (default 0, meaning the number of
+         * hardware threads). */
+        void setNThreads(int nThreads);
+
+        /** Set the gain in decibels to be applied to every item. */
+        void setGainInDecibels(Real gainInDecibels);
+
+        /** Returns the number of items in the batch. */
+        int getNItems() const;
+
+        /** Returns the file name of an item, or an empty string if it is a
+         * buffer. */
+        const string& getItemName(int item) const;
+
+        /** Returns false if an item could not be processed, e.g. a file
+         * could not be opened. */
+        bool isItemProcessed(int item) const;
+
+        /** Returns the number of frames of an item processed by the model. */
+        int getNFrames(int item) const;
+
+        /** Returns a kept result. Empty if a sink is used or the output was
+         * not aggregated. */
+        const RealVec& getAggregatedOutput(int item,
+                const string& outputName) const;
+
+    private:
+
+        struct Item
+        {
+            string fileName;
+            RealVec data;
+            int nChannels, fs, nFrames;
+            Real duration;
+            bool isProcessed;
+            map<string, RealVec> outputs;
+        };
+
+        bool processItem(const Model& prototype, Item& item, int itemIdx);
+        unique_ptr<Model> acquireModel(const Model& prototype,
+                const SignalBank& input);
+        void releaseModel(const SignalBank& input, unique_ptr<Model> model);
+
+        int nThreads_;
+        Real gainInDecibels_;
+        BatchSink* sink_;
+        vector<Item> items_;
+        map<std::pair<int, int>, vector<unique_ptr<Model>>> idleModels_;
+        map<std::pair<int, int>, unique_ptr<Model>> specModels_;
+        std::mutex modelMutex_, sinkMutex_;
+        RealVec emptyOutput_;
+    };
+}
+#endif
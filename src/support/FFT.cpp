@@ -18,9 +18,22 @@
  */
 
 #include "FFT.h"
+#include <mutex>
 
 namespace loudness{
 
+    namespace {
+
+        //only fftw_execute and its new-array variants are thread safe
+        std::mutex plannerMutex;
+
+        void destroyPlan(fftw_plan plan)
+        {
+            std::lock_guard<std::mutex> lock(plannerMutex);
+            fftw_destroy_plan(plan);
+        }
+    }
+
     FFT::FFT(int fftSize) :
         fftSize_(fftSize),
         nReals_(0),
@@ -30,6 +43,23 @@ namespace loudness{
         LOUDNESS_DEBUG("FFT: Constructed");
     }
 
+    FFT::FFT(const FFT& other) :
+        fftSize_(other.fftSize_),
+        nReals_(other.nReals_),
+        nImags_(other.nImags_),
+        nPositiveComponents_(other.nPositiveComponents_),
+        initialized_(other.initialized_),
+        fftPlan_(other.fftPlan_)
+    {
+        //plans are executed on new arrays with the same alignment
+        if (initialized_)
+        {
+            fftInputBuf_ = (Real*) fftw_malloc(sizeof(Real) * fftSize_);
+            fftOutputBuf_ = (Real*) fftw_malloc(sizeof(Real) * fftSize_);
+        }
+        LOUDNESS_DEBUG("FFT: Copy constructed");
+    }
+
     FFT::~FFT()
     { 
         freeFFTW();
@@ -43,8 +73,9 @@ namespace loudness{
             fftw_free(fftOutputBuf_);
             LOUDNESS_DEBUG("FFT: Buffers destroyed.");
 
-            fftw_destroy_plan(fftPlan_);
-            LOUDNESS_DEBUG("FFT: Plan destroyed.");
+            fftPlan_.reset();
+            LOUDNESS_DEBUG("FFT: Plan released.");
+            initialized_ = false;
         }
     }
 
@@ -59,8 +90,13 @@ namespace loudness{
         fftOutputBuf_ = (Real*) fftw_malloc(sizeof(Real) * fftSize_);
         LOUDNESS_DEBUG("FFT: Allocated input and output buffers for an FFT size of " << fftSize_);
         
-        fftPlan_ = fftw_plan_r2r_1d(fftSize_, fftInputBuf_,
-                fftOutputBuf_, FFTW_R2HC, FFTW_PATIENT);
+        fftw_plan plan;
+        {
+            std::lock_guard<std::mutex> lock(plannerMutex);
+            plan = fftw_plan_r2r_1d(fftSize_, fftInputBuf_, fftOutputBuf_,
+                    FFTW_R2HC, FFTW_PATIENT);
+        }
+        fftPlan_.reset(plan, destroyPlan);
 
         LOUDNESS_DEBUG("FFT: Plan set up");
 
@@ -89,7 +125,7 @@ namespace loudness{
                 fftInputBuf_[i] = input[i];
 
             //compute fft
-            fftw_execute(fftPlan_);
+            fftw_execute_r2r(fftPlan_.get(), fftInputBuf_, fftOutputBuf_);
         }
     }
 
@@ -58,6 +58,10 @@ namespace loudness{
      *
      * @todo Develop window class to allow for more functions.
      *
+     * Plans are created and destroyed under a global lock, since the FFTW
+     * planner is not thread safe, so FFT objects may be initialised on
+     * different threads at the same time. Executing a plan is lock free.
+     *
      * @author Dominic Ward
      *
      * @sa FrameGenerator
@@ -75,6 +79,12 @@ namespace loudness{
          */
         FFT(int fftSize);
 
+        /** Copies an FFT object. The copy has its own buffers but shares
+         * the (immutable) FFTW plan of other, so no planning is required. */
+        FFT(const FFT& other);
+
+        FFT& operator=(const FFT&) = delete;
+
         ~FFT();
 
         bool initialize();
@@ -106,7 +116,7 @@ namespace loudness{
         bool initialized_;
         Real *fftInputBuf_;
         Real *fftOutputBuf_;
-        fftw_plan fftPlan_;
+        std::shared_ptr<fftw_plan_s> fftPlan_;
     };
 }
 
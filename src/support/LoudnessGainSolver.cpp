@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "LoudnessGainSolver.h"
+
+namespace loudness{
+
+    LoudnessGainSolver::LoudnessGainSolver(const string& outputName,
+            LoudnessDescriptors::Descriptor descriptor,
+            const string& spectrumName) :
+        outputName_(outputName),
+        spectrumName_(spectrumName),
+        descriptor_(descriptor),
+        tolerance_(0.001),
+        maxIterations_(20),
+        nIterations_(0),
+        isConverged_(false)
+    {
+        LOUDNESS_DEBUG("LoudnessGainSolver: Constructed");
+    }
+
+    LoudnessGainSolver::~LoudnessGainSolver() {};
+
+    bool LoudnessGainSolver::cache(Model& model, const SignalBank& input,
+            int nHops)
+    {
+        trigs_.clear();
+        spectra_.clear();
+
+        if (!model.isInitialized() || model.isFrameParallelActive())
+        {
+            LOUDNESS_ERROR("LoudnessGainSolver: "
+                    << "Model must be initialised and not frame parallel.");
+            return 0;
+        }
+
+        if (!model.hasOutput(spectrumName_) ||
+                !model.hasOutput(outputName_ + "Descriptors"))
+        {
+            LOUDNESS_ERROR("LoudnessGainSolver: Model has no output "
+                    << spectrumName_ << " or does not describe "
+                    << outputName_);
+            return 0;
+        }
+
+        if ((nHops < 1) || (input.getNSamples() < nHops) ||
+                (input.getNSamples() % nHops))
+        {
+            LOUDNESS_ERROR("LoudnessGainSolver: Input of "
+                    << input.getNSamples() << " samples does not hold "
+                    << nHops << " whole hops.");
+            return 0;
+        }
+
+        int hopSize = input.getNSamples() / nHops;
+        SignalBank hop;
+        hop.initialize(input.getNSources(), input.getNEars(),
+                input.getNChannels(), hopSize, input.getFs());
+
+        const SignalBank& spectrum = model.getOutput(spectrumName_);
+        int nSamples = spectrum.getNTotalSamples();
+        model.reset();
+        for (int h = 0; h < nHops; ++h)
+        {
+            for (int src = 0; src < input.getNSources(); ++src)
+            {
+                for (int ear = 0; ear < input.getNEars(); ++ear)
+                {
+                    for (int chn = 0; chn < input.getNChannels(); ++chn)
+                    {
+                        hop.copySamples(src, ear, chn, 0,
+                                input.getSignalReadPointer
+                                (src, ear, chn, h * hopSize),
+                                hopSize);
+                    }
+                }
+            }
+            model.process(hop);
+
+            //only triggered spectra are passed on by the model
+            trigs_.push_back(spectrum.getTrig());
+            if (spectrum.getTrig())
+            {
+                const Real* x = spectrum.getSignalReadPointer(0, 0, 0, 0);
+                spectra_.insert(spectra_.end(), x, x + nSamples);
+            }
+        }
+        model.synchronize();
+        spectrum_.initialize(spectrum);
+
+        LOUDNESS_DEBUG("LoudnessGainSolver: Cached "
+                << spectra_.size() / max(nSamples, 1) << " spectra.");
+        return 1;
+    }
+
+    Real LoudnessGainSolver::computeLoudness(Model& model,
+            Real gainInDecibels)
+    {
+        if (trigs_.empty())
+        {
+            LOUDNESS_ERROR("LoudnessGainSolver: Nothing cached.");
+            return 0.0;
+        }
+
+        Real scale = pow(10.0, gainInDecibels / 10.0);
+        int nSamples = spectrum_.getNTotalSamples();
+        const Real* cached = spectra_.data();
+        Real* x = spectrum_.getSignalWritePointer(0, 0, 0, 0);
+
+        model.resetDownstream(spectrumName_);
+        for (bool trig : trigs_)
+        {
+            if (trig)
+            {
+                for (int i = 0; i < nSamples; ++i)
+                    x[i] = scale * cached[i];
+                cached += nSamples;
+            }
+            spectrum_.setTrig(trig);
+            model.replayOutput(spectrumName_, spectrum_);
+        }
+        model.synchronize();
+
+        return model.getOutput(outputName_ + "Descriptors").getSample
+            (0, 0, 0, descriptor_);
+    }
+
+    Real LoudnessGainSolver::solve(Model& model, Real targetLoudness,
+            Real initialGainInDecibels)
+    {
+        isConverged_ = false;
+        nIterations_ = 0;
+        if (trigs_.empty() || (targetLoudness <= 0))
+        {
+            LOUDNESS_ERROR("LoudnessGainSolver: "
+                    << "Nothing cached or target loudness not positive.");
+            return initialGainInDecibels;
+        }
+
+        //largest change in gain per iteration
+        const Real maxStep = 40.0;
+
+        //gains known to give a loudness below and above the target
+        Real lowerGain = 0, upperGain = 0;
+        bool hasLowerGain = false, hasUpperGain = false;
+
+        Real gain = initialGainInDecibels, bestGain = gain;
+        Real prevGain = 0, prevError = 0, bestError = -1;
+        bool hasPrev = false;
+        while (nIterations_ < maxIterations_)
+        {
+            Real loudness = computeLoudness(model, gain);
+            ++nIterations_;
+
+            Real nextGain;
+            if (loudness > 0)
+            {
+                Real relativeError = fabs(loudness / targetLoudness - 1.0);
+                if ((bestError < 0) || (relativeError < bestError))
+                {
+                    bestError = relativeError;
+                    bestGain = gain;
+                }
+                if (relativeError <= tolerance_)
+                {
+                    isConverged_ = true;
+                    break;
+                }
+
+                //log loudness is close to linear in decibels
+                Real error = log(loudness / targetLoudness);
+                if (error < 0)
+                {
+                    lowerGain = gain;
+                    hasLowerGain = true;
+                }
+                else
+                {
+                    upperGain = gain;
+                    hasUpperGain = true;
+                }
+
+                if (hasPrev && (error != prevError))
+                    nextGain = gain - error * (gain - prevGain) /
+                        (error - prevError);
+                else //loudness roughly doubles every 10 dB
+                    nextGain = gain - error * 10.0 / log(2.0);
+
+                prevGain = gain;
+                prevError = error;
+                hasPrev = true;
+            }
+            else
+            {
+                //inaudible, so the target needs more gain
+                lowerGain = gain;
+                hasLowerGain = true;
+                nextGain = gain + maxStep;
+            }
+
+            nextGain = min(max(nextGain, gain - maxStep), gain + maxStep);
+            if (hasLowerGain && hasUpperGain)
+            {
+                if (!((nextGain > lowerGain) && (nextGain < upperGain)))
+                    nextGain = 0.5 * (lowerGain + upperGain);
+                if (nextGain == gain)
+                    break;
+            }
+            gain = nextGain;
+        }
+
+        if (!isConverged_)
+        {
+            LOUDNESS_WARNING("LoudnessGainSolver: Not converged after "
+                    << nIterations_ << " iterations.");
+        }
+
+        LOUDNESS_DEBUG("LoudnessGainSolver: Gain " << bestGain
+                << " dB after " << nIterations_ << " iterations.");
+        return bestGain;
+    }
+
+    void LoudnessGainSolver::setTolerance(Real tolerance)
+    {
+        tolerance_ = tolerance;
+    }
+
+    void LoudnessGainSolver::setMaxIterations(int maxIterations)
+    {
+        maxIterations_ = maxIterations;
+    }
+
+    bool LoudnessGainSolver::isConverged() const
+    {
+        return isConverged_;
+    }
+
+    int LoudnessGainSolver::getNIterations() const
+    {
+        return nIterations_;
+    }
+
+    int LoudnessGainSolver::getNHops() const
+    {
+        return (int)trigs_.size();
+    }
+}
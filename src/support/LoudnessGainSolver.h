@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef LOUDNESSGAINSOLVER_H
+#define LOUDNESSGAINSOLVER_H
+
+#include "Model.h"
+#include "../modules/LoudnessDescriptors.h"
+
+namespace loudness{
+
+    /**
+     * @class LoudnessGainSolver
+     *
+     * @brief Finds the broadband gain giving a signal a target loudness,
+     * running the spectral front end of a model only once.
+     *
+     * A broadband gain scales the power spectrum by a constant, and every
+     * module up to the weighted spectrum (filters, frame generator, window,
+     * FFT, compression and outer/middle ear weighting) is linear in power.
+     * cache() therefore processes the signal once and stores the weighted
+     * spectrum of every hop. Each loudness evaluation then replays the
+     * scaled spectra through the remaining modules only (excitation,
+     * specific loudness and temporal integration, see
+     * Model::replayOutput()). At a gain of 0 dB the result is identical to
+     * processing the signal; otherwise it differs by rounding only.
+     *
+     * The loudness is a descriptor (see LoudnessDescriptors) of a model
+     * output, so the model must describe that output (see
+     * Model::setOutputsToDescribe()). solve() uses the secant method on the
+     * logarithm of the loudness, which is nearly linear in decibels, and
+     * bisects once the target is bracketed if a secant step leaves the
+     * bracket.
+     *
+     * The model must be initialised with a SignalBank of one hop and must
+     * not use frame parallel processing.
+     *
+     * @sa DynamicLoudnessGM2002, DynamicLoudnessCH2012
+     */
+    class LoudnessGainSolver
+    {
+    public:
+        /**
+         * @brief Constructs a solver.
+         *
+         * @param outputName The model output whose descriptor is matched.
+         * @param descriptor The descriptor of the output to match.
+         * @param spectrumName The model output holding the weighted power
+         * spectrum.
+         */
+        LoudnessGainSolver(const string& outputName = "ShortTermLoudness",
+                LoudnessDescriptors::Descriptor descriptor =
+                LoudnessDescriptors::MEAN,
+                const string& spectrumName = "WeightedSpectrum");
+
+        ~LoudnessGainSolver();
+
+        /**
+         * @brief Processes nHops consecutive hops of input with model and
+         * caches the weighted spectrum of each hop. The number of samples
+         * in input must be a multiple of nHops.
+         *
+         * @return true if the spectra were cached, false otherwise.
+         */
+        bool cache(Model& model, const SignalBank& input, int nHops);
+
+        /**
+         * @brief Returns the loudness descriptor of the cached signal with
+         * a gain of gainInDecibels applied.
+         */
+        Real computeLoudness(Model& model, Real gainInDecibels);
+
+        /**
+         * @brief Returns the gain in decibels at which the loudness
+         * descriptor of the cached signal equals targetLoudness.
+         *
+         * If the search does not converge (see isConverged()), the gain
+         * giving the closest loudness is returned.
+         */
+        Real solve(Model& model, Real targetLoudness,
+                Real initialGainInDecibels = 0.0);
+
+        /** Sets the relative loudness error at which solve() stops
+         * (default 0.001). */
+        void setTolerance(Real tolerance);
+
+        /** Sets the maximum number of loudness evaluations per solve()
+         * (default 20). */
+        void setMaxIterations(int maxIterations);
+
+        /** Returns true if the last solve() converged. */
+        bool isConverged() const;
+
+        /** Returns the number of loudness evaluations of the last solve(). */
+        int getNIterations() const;
+
+        /** Returns the number of hops cached. */
+        int getNHops() const;
+
+    private:
+        string outputName_, spectrumName_;
+        LoudnessDescriptors::Descriptor descriptor_;
+        Real tolerance_;
+        int maxIterations_, nIterations_;
+        bool isConverged_;
+        vector<bool> trigs_;
+        RealVec spectra_;
+        SignalBank spectrum_;
+    };
+}
+
+#endif
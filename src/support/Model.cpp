@@ -18,23 +18,224 @@
  */
 
 #include "Model.h"
+#include "../modules/LoudnessDescriptors.h"
+#include "../modules/ChannelSelector.h"
+#include "../modules/PipelineStage.h"
+#include "../modules/FrameGate.h"
 
 namespace loudness{
 
+    namespace {
+
+        //bump when the layout written by Module::saveState() changes
+        const Real stateFormatVersion = 1;
+
+        //hashes the name, configuration and output structure of a module
+        void hashModule(const Module& module, unsigned long long& hash)
+        {
+            const string& name = module.getName();
+            const SignalBank& output = module.getOutput();
+            int shape[] = {output.getNSources(), output.getNEars(),
+                output.getNChannels(), output.getNSamples()};
+            Real rates[] = {(Real)output.getFs(), output.getFrameRate()};
+            hashBytes(name.data(), name.size(), hash);
+            hashBytes(shape, sizeof(shape), hash);
+            hashBytes(rates, sizeof(rates), hash);
+            hashBytes(output.getCentreFreqs().data(),
+                    output.getNChannels() * sizeof(Real), hash);
+            module.hashConfiguration(hash);
+        }
+    }
+
     Model::Model(string name, bool isDynamic) :
         name_(name),
         isDynamic_(isDynamic),
-        rate_(0.0)
+        initialized_(false),
+        areParallelBranchesUsed_(false),
+        areParallelSlicesUsed_(false),
+        areParallelChannelsUsed_(false),
+        isPipelineUsed_(false),
+        isFrameParallelUsed_(false),
+        isFrameParallelActive_(false),
+        isFrameSkippingUsed_(false),
+        isEarMirroringUsed_(false),
+        nModules_(0),
+        nThreads_(0),
+        nParallelBranchPoints_(0),
+        pipelineQueueDepth_(8),
+        frameParallelBlockSize_(1024),
+        nBufferedFrames_(0),
+        rate_(0.0),
+        threadSpinTime_(0.0002),
+        silenceThresholdInDB_(-20.0),
+        steadyStateTolerance_(0.01),
+        earMirroringTolerance_(0.0),
+        frameSource_(nullptr)
     {
         LOUDNESS_DEBUG(name_ << ": Constructed.");
     }
 
-    Model::~Model() {}
+    Model::Model(const Model& other) :
+        name_(other.name_),
+        isDynamic_(other.isDynamic_),
+        initialized_(false),
+        areParallelBranchesUsed_(other.areParallelBranchesUsed_),
+        areParallelSlicesUsed_(other.areParallelSlicesUsed_),
+        areParallelChannelsUsed_(other.areParallelChannelsUsed_),
+        isPipelineUsed_(other.isPipelineUsed_),
+        isFrameParallelUsed_(other.isFrameParallelUsed_),
+        isFrameParallelActive_(false),
+        isFrameSkippingUsed_(other.isFrameSkippingUsed_),
+        isEarMirroringUsed_(other.isEarMirroringUsed_),
+        nModules_(0),
+        nThreads_(other.nThreads_),
+        nParallelBranchPoints_(0),
+        pipelineQueueDepth_(other.pipelineQueueDepth_),
+        frameParallelBlockSize_(other.frameParallelBlockSize_),
+        nBufferedFrames_(0),
+        rate_(other.rate_),
+        threadSpinTime_(other.threadSpinTime_),
+        silenceThresholdInDB_(other.silenceThresholdInDB_),
+        steadyStateTolerance_(other.steadyStateTolerance_),
+        earMirroringTolerance_(other.earMirroringTolerance_),
+        outputsToAggregate_(other.outputsToAggregate_),
+        outputsToDescribe_(other.outputsToDescribe_),
+        pipelineStageOutputs_(other.pipelineStageOutputs_),
+        blockOutputs_(other.blockOutputs_),
+        frameSource_(nullptr)
+    {
+        LOUDNESS_DEBUG(name_ << ": Copy constructed.");
+    }
+
+    Model::~Model()
+    {
+        //stage threads must be idle before modules are destroyed
+        nBufferedFrames_ = 0;
+        synchronize();
+    }
+
+    Model* Model::clone() const
+    {
+        Model* model = copyConfiguration();
+        if (model && initialized_)
+        {
+            if (!model -> cloneModules(*this))
+                model -> initialize(input_);
+            model -> reset();
+        }
+        return model;
+    }
+
+    Model* Model::copyConfiguration() const
+    {
+        return nullptr;
+    }
+
+    bool Model::cloneModules(const Model& other)
+    {
+        //these graphs are rewired or have threads of their own
+        if (other.isFrameParallelActive_ || !other.pipelineStages_.empty())
+            return 0;
+
+        std::map<const Module*, Module*> clones;
+        for (const auto &module : other.modules_)
+        {
+            Module* clone = module -> clone();
+            if (!clone)
+            {
+                LOUDNESS_DEBUG(name_ << ": " << module -> getName()
+                        << " cannot be cloned.");
+                modules_.clear();
+                return 0;
+            }
+            modules_.push_back(unique_ptr<Module> (clone));
+            clones[module.get()] = clone;
+        }
+
+        for (auto &module : modules_)
+        {
+            vector<Module*> targets = module -> getTargetModules();
+            for (uint i = 0; i < targets.size(); ++i)
+                module -> removeLastTargetModule();
+            for (auto target : targets)
+                module -> addTargetModule(*clones[target]);
+        }
+
+        for (const auto &output : other.outputModules_)
+            outputModules_[output.first] = clones[output.second];
+        for (auto gate : other.frameGates_)
+            frameGates_.push_back(static_cast<FrameGate*> (clones[gate]));
+
+        nModules_ = other.nModules_;
+        input_.initialize(other.input_);
+
+        //the copies point to the thread pool of other
+        configureParallelProcessing();
+
+        initialized_ = true;
+        LOUDNESS_DEBUG(name_ << ": Modules cloned.");
+        return 1;
+    }
+
+    Module* Model::adoptModules(Model& model, const SignalBank &input,
+            const string& outputPrefix)
+    {
+        model.outputModules_.clear();
+        model.modules_.clear();
+        if (!model.initializeInternal(input) || model.modules_.empty())
+        {
+            LOUDNESS_ERROR(name_ << ": " << model.name_
+                    << " cannot be initialised.");
+            model.outputModules_.clear();
+            model.modules_.clear();
+            return nullptr;
+        }
+
+        Module* root = model.modules_[0].get();
+        for (auto &module : model.modules_)
+            modules_.push_back(std::move(module));
+        for (const auto &output : model.outputModules_)
+            outputModules_[outputPrefix + output.first] = output.second;
+        model.outputModules_.clear();
+        model.modules_.clear();
+        return root;
+    }
+
+    vector<string> Model::getModelOptionsInUse(const Model& model) const
+    {
+        vector<string> options;
+        if (!model.outputsToAggregate_.empty())
+            options.push_back("outputs to aggregate");
+        if (!model.outputsToDescribe_.empty())
+            options.push_back("outputs to describe");
+        if (!model.blockOutputs_.empty())
+            options.push_back("block outputs");
+        if (model.isPipelineUsed_)
+            options.push_back("pipeline");
+        if (model.isFrameParallelUsed_)
+            options.push_back("frame parallel processing");
+        if (model.areParallelBranchesUsed_ || model.areParallelSlicesUsed_ ||
+                model.areParallelChannelsUsed_)
+            options.push_back("parallel processing");
+        if (model.isFrameSkippingUsed_)
+            options.push_back("frame skipping");
+        if (model.isEarMirroringUsed_)
+            options.push_back("ear mirroring");
+        return options;
+    }
 
     bool Model::initialize(const SignalBank &input)
     {
+        //pending hops are discarded
+        nBufferedFrames_ = 0;
+        synchronize();
+        isFrameParallelActive_ = false;
+        frameWorkers_.clear();
+        pipelineStages_.clear();
+        frameGates_.clear();
         outputModules_.clear();
         modules_.clear();
+        input_.initialize(input);
 
         if(!initializeInternal(input))
         {
@@ -50,13 +251,27 @@ namespace loudness{
             }
             LOUDNESS_DEBUG(name_ << ": initialised.");
 
+            configureFrameSkipping();
+
+            configureOutputDescriptors();
+
+            configurePipelineStages();
+
             nModules_ = (int)modules_.size();
 
+            //before initialisation so modules can allocate per slice memory
+            configureParallelProcessing();
+
+            if (isEarMirroringUsed_)
+                configureEarMirroring(modules_[0].get());
+
             //initialise all from root module
             modules_[0] -> initialize(input);
 
             configureSignalBankAggregation();
 
+            configureFrameParallel(input);
+
             LOUDNESS_DEBUG(name_ 
                     << ": Module targets set and initialised.");
 
@@ -68,15 +283,254 @@ namespace loudness{
     void Model::process(const SignalBank &input)
     {
         if (initialized_)
+        {
             modules_[0] -> process(input);
+
+            if (isFrameParallelActive_)
+            {
+                //phase 1 done, keep the frame for the stateless section
+                SignalBank& frame = frames_[nBufferedFrames_++];
+                frame.copySamples(frameSource_ -> getOutput());
+                frame.setTrig(frameSource_ -> getOutput().getTrig());
+                if (nBufferedFrames_ == frameParallelBlockSize_)
+                    processFrameBlock();
+            }
+        }
         else
+        {
             LOUDNESS_WARNING(name_ << ": Not initialised!");
+        }
+    }
+
+    bool Model::processBlock(const SignalBank &input, int nHops)
+    {
+        if (!initialized_)
+        {
+            LOUDNESS_WARNING(name_ << ": Not initialised!");
+            return 0;
+        }
+
+        int hopSize = input_.getNSamples();
+        if ((input.getNSources() != input_.getNSources()) ||
+                (input.getNEars() != input_.getNEars()) ||
+                (input.getNChannels() != input_.getNChannels()) ||
+                (nHops < 0) || (input.getNSamples() < nHops * hopSize))
+        {
+            LOUDNESS_ERROR(name_ << ": Input does not hold " << nHops
+                    << " hops of " << hopSize << " samples.");
+            return 0;
+        }
+
+        auto loadHop = [&](int hop)
+        {
+            for (int src = 0; src < input_.getNSources(); ++src)
+            {
+                for (int ear = 0; ear < input_.getNEars(); ++ear)
+                {
+                    for (int chn = 0; chn < input_.getNChannels(); ++chn)
+                    {
+                        input_.copySamples(src, ear, chn, 0,
+                                input.getSignalReadPointer
+                                (src, ear, chn, hop * hopSize),
+                                hopSize);
+                    }
+                }
+            }
+        };
+
+        return processHops(nHops, loadHop, blockOutputs_,
+                map<string, Real*>());
+    }
+
+    bool Model::processHops(int nHops,
+            const std::function<void(int)>& loadHop,
+            const vector<string>& outputNames,
+            const map<string, Real*>& outputBuffers)
+    {
+        /*
+         * Outputs are collected by aggregation so that rows are also
+         * produced by pipeline stages and frame parallel replay. Anything
+         * aggregated by the user is left in place.
+         */
+        vector<string> names;
+        vector<Module*> modules;
+        vector<bool> wereAggregated, areBuffered;
+        vector<size_t> offsets;
+        for (const string& name : outputNames)
+        {
+            auto search = outputModules_.find(name);
+            if (search == outputModules_.end())
+            {
+                LOUDNESS_WARNING(name_ << ": " << name
+                        << " is not a valid output name.");
+                continue;
+            }
+            Module* module = search -> second;
+            auto buffer = outputBuffers.find(name);
+            names.push_back(name);
+            modules.push_back(module);
+            wereAggregated.push_back(module -> isOutputAggregated());
+            areBuffered.push_back(buffer != outputBuffers.end());
+            offsets.push_back(module -> getOutput().getAggregatedSignals().size());
+            if (areBuffered.back())
+                module -> setAggregationBuffer(buffer -> second, nHops);
+            module -> setOutputAggregated(true);
+        }
+
+        for (int hop = 0; hop < nHops; ++hop)
+        {
+            loadHop(hop);
+            process(input_);
+        }
+        synchronize();
+
+        blockOutputBanks_.clear();
+        for (uint i = 0; i < modules.size(); ++i)
+        {
+            const SignalBank& output = modules[i] -> getOutput();
+            if (areBuffered[i])
+            {
+                modules[i] -> setAggregationBuffer(nullptr, 0);
+            }
+            else
+            {
+                const RealVec& aggregated = output.getAggregatedSignals();
+                SignalBank& block = blockOutputBanks_[names[i]];
+                block.initialize(output);
+                block.setAggregatedSignals(RealVec (aggregated.begin() +
+                            offsets[i], aggregated.end()));
+            }
+
+            if (!wereAggregated[i])
+            {
+                modules[i] -> setOutputAggregated(false);
+                modules[i] -> setAggregatedOutput(RealVec());
+            }
+        }
+
+        return 1;
+    }
+
+    int Model::processSignal(const Real* signal, int nSources, int nEars,
+            int nSamples, int nSamplesToPadStart, int nSamplesToPadEnd,
+            const map<string, Real*>& outputBuffers)
+    {
+        if (!initialized_)
+        {
+            LOUDNESS_WARNING(name_ << ": Not initialised!");
+            return 0;
+        }
+
+        if ((nSources != input_.getNSources()) ||
+                (nEars != input_.getNEars()) ||
+                (input_.getNChannels() != 1))
+        {
+            LOUDNESS_ERROR(name_ << ": Signal has " << nSources
+                    << " sources and " << nEars << " ears, model expects "
+                    << input_.getNSources() << " and " << input_.getNEars());
+            return 0;
+        }
+
+        if ((nSamples < 0) || (nSamplesToPadStart < 0) ||
+                (nSamplesToPadEnd < 0))
+        {
+            LOUDNESS_ERROR(name_ << ": Invalid signal or padding length.");
+            return 0;
+        }
+
+        //each hop is copied from the signal, zeros stand in for the padding
+        int hopSize = input_.getNSamples();
+        auto loadHop = [&](int hop)
+        {
+            int start = hop * hopSize - nSamplesToPadStart;
+            int begin = std::min(hopSize, std::max(0, -start));
+            int end = std::max(begin, std::min(hopSize, nSamples - start));
+            for (int src = 0; src < nSources; ++src)
+            {
+                for (int ear = 0; ear < nEars; ++ear)
+                {
+                    const Real* x = signal + (src * nEars + ear) * nSamples;
+                    Real* y = input_.getSignalWritePointer(src, ear, 0, 0);
+                    std::fill(y, y + begin, 0.0);
+                    if (end > begin)
+                        std::copy(x + start + begin, x + start + end,
+                                y + begin);
+                    std::fill(y + end, y + hopSize, 0.0);
+                }
+            }
+        };
+
+        //buffered outputs are collected without changing the block outputs
+        vector<string> outputNames = blockOutputs_;
+        for (const auto &buffer : outputBuffers)
+        {
+            if (std::find(outputNames.begin(), outputNames.end(),
+                        buffer.first) == outputNames.end())
+                outputNames.push_back(buffer.first);
+        }
+
+        int nHops = getNSignalHops(nSamples, nSamplesToPadStart,
+                nSamplesToPadEnd);
+        if (!processHops(nHops, loadHop, outputNames, outputBuffers))
+            return 0;
+        return nHops;
+    }
+
+    int Model::getNSignalHops(int nSamples, int nSamplesToPadStart,
+            int nSamplesToPadEnd) const
+    {
+        int hopSize = input_.getNSamples();
+        if (hopSize == 0)
+            return 0;
+        return (nSamplesToPadStart + nSamples + nSamplesToPadEnd +
+                hopSize - 1) / hopSize;
+    }
+
+    void Model::setBlockOutputs(const vector<string>& blockOutputs)
+    {
+        blockOutputs_ = blockOutputs;
+    }
+
+    const SignalBank& Model::getBlockOutput(const string& outputName) const
+    {
+        auto search = blockOutputBanks_.find(outputName);
+        LOUDNESS_ASSERT(search != blockOutputBanks_.end(),
+                name_ << ": No block for " << outputName);
+        return search -> second;
+    }
+
+    vector<string> Model::getBlockOutputNames() const
+    {
+        vector<string> outputNames;
+        for (const auto &block : blockOutputBanks_)
+            outputNames.push_back(block.first);
+        return outputNames;
     }
 
     void Model::reset()
     {
         if (initialized_)
+        {
             modules_[0] -> reset();
+
+            //the stateless section is detached from the front end
+            if (isFrameParallelActive_)
+            {
+                nBufferedFrames_ = 0;
+                for (int idx : statelessRootIdx_)
+                    modules_[idx] -> reset();
+            }
+        }
+    }
+
+    void Model::synchronize()
+    {
+        if (isFrameParallelActive_ && (nBufferedFrames_ > 0))
+            processFrameBlock();
+
+        //upstream stages are drained first
+        for (auto stage : pipelineStages_)
+            stage -> synchronize();
     }
 
     void Model::configureLinearTargetModuleChain(int moduleIdx)
@@ -86,6 +540,23 @@ namespace loudness{
             modules_[i] -> addTargetModule(*modules_[i + 1]);
     }
 
+    void Model::configureTemporalIntegration(Module* integrator,
+            const string& loudnessName)
+    {
+        Module* source = modules_.back().get();
+        modules_.push_back(unique_ptr<Module> (integrator));
+        source -> addTargetModule(*integrator);
+
+        const string stages[] = {"Instantaneous", "ShortTerm", "LongTerm"};
+        for (int chn = 0; chn < 3; ++chn)
+        {
+            modules_.push_back(unique_ptr<Module>
+                    (new ChannelSelector(chn, 1)));
+            integrator -> addTargetModule(*modules_.back());
+            outputModules_[stages[chn] + loudnessName] = modules_.back().get();
+        }
+    }
+
     void Model::setOutputsToAggregate(const vector<string>& outputsToAggregate)
     {
         outputsToAggregate_ = outputsToAggregate;
@@ -108,6 +579,11 @@ namespace loudness{
                     outputsToAggregate_.end(), outputToAggregate));
     }
 
+    void Model::setOutputsToDescribe(const vector<string>& outputsToDescribe)
+    {
+        outputsToDescribe_ = outputsToDescribe;
+    }
+
     const SignalBank& Model::getOutput(const string& outputName) const
     {
         auto search = outputModules_.find(outputName);
@@ -115,6 +591,312 @@ namespace loudness{
         return search -> second -> getOutput();
     }
 
+    bool Model::hasOutput(const string& outputName) const
+    {
+        return outputModules_.find(outputName) != outputModules_.end();
+    }
+
+    vector<string> Model::getAggregatedOutputNames() const
+    {
+        vector<string> outputNames;
+        for (const auto &output : outputModules_)
+        {
+            if (output.second -> isOutputAggregated())
+                outputNames.push_back(output.first);
+        }
+        return outputNames;
+    }
+
+    void Model::setAggregatedOutput(const string& outputName,
+            const RealVec& aggregatedSignals)
+    {
+        auto search = outputModules_.find(outputName);
+        LOUDNESS_ASSERT(search != outputModules_.end());
+        search -> second -> setAggregatedOutput(aggregatedSignals);
+    }
+
+    bool Model::replayOutput(const string& outputName,
+            const SignalBank& output)
+    {
+        if (!initialized_ || isFrameParallelActive_)
+        {
+            LOUDNESS_WARNING(name_
+                    << ": Cannot replay, not initialised or frame parallel.");
+            return 0;
+        }
+
+        auto search = outputModules_.find(outputName);
+        if ((search == outputModules_.end()) ||
+                !output.hasSameShape(search -> second -> getOutput()))
+        {
+            LOUDNESS_ERROR(name_ << ": Cannot replay " << outputName);
+            return 0;
+        }
+
+        Module* module = search -> second;
+        module -> replayOutput(output);
+        for (auto target : module -> getTargetModules())
+            target -> process(module -> getOutput());
+        return 1;
+    }
+
+    void Model::resetDownstream(const string& outputName)
+    {
+        auto search = outputModules_.find(outputName);
+        LOUDNESS_ASSERT(search != outputModules_.end());
+        synchronize();
+        for (auto target : search -> second -> getTargetModules())
+            target -> reset();
+    }
+
+    RealVec Model::saveState()
+    {
+        RealVec state;
+        if (!initialized_)
+        {
+            LOUDNESS_WARNING(name_ << ": Not initialised!");
+            return state;
+        }
+
+        //pending hops belong to the saved stream
+        synchronize();
+
+        //the hash is split so that each half is exact as a Real
+        unsigned long long hash = getConfigurationHash();
+        state.push_back(stateFormatVersion);
+        state.push_back((Real)(hash >> 32));
+        state.push_back((Real)(hash & 0xffffffffULL));
+
+        for (const auto &module : modules_)
+        {
+            if (isModuleStateSaved(*module))
+                module -> saveState(state);
+        }
+
+        LOUDNESS_DEBUG(name_ << ": State of " << state.size()
+                << " values saved.");
+        return state;
+    }
+
+    bool Model::loadState(const RealVec& state)
+    {
+        if (!initialized_)
+        {
+            LOUDNESS_WARNING(name_ << ": Not initialised!");
+            return 0;
+        }
+
+        nBufferedFrames_ = 0;
+        synchronize();
+
+        unsigned long long hash = getConfigurationHash();
+        if ((state.size() < 3) ||
+                (state[0] != stateFormatVersion) ||
+                (state[1] != (Real)(hash >> 32)) ||
+                (state[2] != (Real)(hash & 0xffffffffULL)))
+        {
+            LOUDNESS_ERROR(name_
+                    << ": State does not match the model configuration.");
+            reset();
+            return 0;
+        }
+
+        int pos = 3;
+        for (auto &module : modules_)
+        {
+            if (isModuleStateSaved(*module) &&
+                    !module -> loadState(state, pos))
+            {
+                reset();
+                return 0;
+            }
+        }
+
+        if (pos != (int)state.size())
+        {
+            LOUDNESS_ERROR(name_ << ": State has " << state.size() - pos
+                    << " unexpected values.");
+            reset();
+            return 0;
+        }
+
+        LOUDNESS_DEBUG(name_ << ": State loaded.");
+        return 1;
+    }
+
+    void Model::configureFrameSkipping()
+    {
+        if (!isFrameSkippingUsed_)
+            return;
+
+        //an ensemble has one prefixed weighted spectrum per model
+        vector<Module*> spectra;
+        const string outputName = "WeightedSpectrum";
+        for (const auto &output : outputModules_)
+        {
+            const string& name = output.first;
+            bool isSpectrum = (name == outputName) ||
+                ((name.size() > outputName.size()) &&
+                 !name.compare(name.size() - outputName.size() - 1,
+                     outputName.size() + 1, "." + outputName));
+            if (isSpectrum && std::find(spectra.begin(), spectra.end(),
+                        output.second) == spectra.end())
+                spectra.push_back(output.second);
+        }
+
+        if (spectra.empty())
+        {
+            LOUDNESS_WARNING(name_ << ": Frame skipping needs a "
+                    << "WeightedSpectrum output.");
+            return;
+        }
+
+        //each gate takes over all targets of its weighted spectrum
+        for (auto spectrum : spectra)
+        {
+            FrameGate* gate = new FrameGate(silenceThresholdInDB_,
+                    steadyStateTolerance_);
+            modules_.push_back(unique_ptr<Module> (gate));
+            frameGates_.push_back(gate);
+            vector<Module*> targets = spectrum -> getTargetModules();
+            for (auto target : targets)
+            {
+                gate -> addTargetModule(*target);
+                spectrum -> removeLastTargetModule();
+            }
+            spectrum -> addTargetModule(*gate);
+        }
+    }
+
+    void Model::configureEarMirroring(Module* module)
+    {
+        if (module -> isStateless())
+        {
+            LOUDNESS_DEBUG(name_ << ": Comparing ears at "
+                    << module -> getName());
+            module -> setEarComparisonUsed(true, earMirroringTolerance_);
+            return;
+        }
+
+        for (auto target : module -> getTargetModules())
+            configureEarMirroring(target);
+    }
+
+    void Model::setEarMirroringUsed(bool isEarMirroringUsed)
+    {
+        isEarMirroringUsed_ = isEarMirroringUsed;
+    }
+
+    void Model::setEarMirroringTolerance(Real earMirroringTolerance)
+    {
+        earMirroringTolerance_ = earMirroringTolerance;
+    }
+
+    void Model::setFrameSkippingUsed(bool isFrameSkippingUsed)
+    {
+        isFrameSkippingUsed_ = isFrameSkippingUsed;
+    }
+
+    void Model::setSilenceThreshold(Real silenceThresholdInDB)
+    {
+        silenceThresholdInDB_ = silenceThresholdInDB;
+    }
+
+    void Model::setSteadyStateTolerance(Real steadyStateTolerance)
+    {
+        steadyStateTolerance_ = steadyStateTolerance;
+    }
+
+    long long Model::getNGatedFrames() const
+    {
+        long long nFrames = 0;
+        for (auto gate : frameGates_)
+            nFrames += gate -> getNFrames();
+        return nFrames;
+    }
+
+    long long Model::getNSkippedSilentFrames() const
+    {
+        long long nFrames = 0;
+        for (auto gate : frameGates_)
+            nFrames += gate -> getNSilentFrames();
+        return nFrames;
+    }
+
+    long long Model::getNSkippedSteadyFrames() const
+    {
+        long long nFrames = 0;
+        for (auto gate : frameGates_)
+            nFrames += gate -> getNSteadyFrames();
+        return nFrames;
+    }
+
+    bool Model::isPipelineStage(const Module& module) const
+    {
+        for (auto stage : pipelineStages_)
+        {
+            if (stage == &module)
+                return 1;
+        }
+        return 0;
+    }
+
+    bool Model::isModuleStateSaved(const Module& module) const
+    {
+        //pipeline stages are empty once synchronised
+        if (isPipelineStage(module))
+            return false;
+        if (!module.isStateless())
+            return true;
+
+        //skipped frames reuse the outputs of the gated stateless modules
+        vector<Module*> gated;
+        for (auto gate : frameGates_)
+            collectSubtree(gate, gated);
+        return std::find(gated.begin(), gated.end(), &module) != gated.end();
+    }
+
+    unsigned long long Model::getConfigurationHash() const
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+        hashBytes(name_.data(), name_.size(), hash);
+        for (const auto &module : modules_)
+        {
+            if (!isPipelineStage(*module))
+                hashModule(*module, hash);
+        }
+        return hash;
+    }
+
+    unsigned long long Model::getUpstreamHash(const string& outputName) const
+    {
+        auto search = outputModules_.find(outputName);
+        LOUDNESS_ASSERT(search != outputModules_.end());
+
+        unsigned long long hash = 14695981039346656037ULL;
+        hashBytes(name_.data(), name_.size(), hash);
+        for (const auto &module : modules_)
+        {
+            if (isPipelineStage(*module))
+                continue;
+
+            //modules from which the output can be reached; frame parallel
+            //processing detaches the stateless section from its source
+            vector<Module*> subtree;
+            collectSubtree(module.get(), subtree);
+            if (isFrameParallelActive_ && std::find(subtree.begin(),
+                        subtree.end(), frameSource_) != subtree.end())
+            {
+                for (int idx : statelessRootIdx_)
+                    collectSubtree(modules_[idx].get(), subtree);
+            }
+            if (std::find(subtree.begin(), subtree.end(), search -> second)
+                    != subtree.end())
+                hashModule(*module, hash);
+        }
+        return hash;
+    }
+
     void Model::configureSignalBankAggregation()
     {
         for (const auto &outputName : outputsToAggregate_)
@@ -128,6 +910,453 @@ namespace loudness{
         }
     }
 
+    void Model::configureOutputDescriptors()
+    {
+        for (const auto &outputName : outputsToDescribe_)
+        {
+            auto search = outputModules_.find(outputName);
+            if (search != outputModules_.end())
+            {
+                LOUDNESS_DEBUG(name_ << ": Describing : " << search -> first);
+                modules_.push_back(unique_ptr<Module> (new LoudnessDescriptors));
+                search -> second -> addTargetModule (*modules_.back());
+                outputModules_[outputName + "Descriptors"] = modules_.back().get();
+            }
+            else
+            {
+                LOUDNESS_WARNING(name_ << ": Cannot describe unknown output : "
+                        << outputName);
+            }
+        }
+    }
+
+    void Model::configurePipelineStages()
+    {
+        if (!isPipelineUsed_)
+            return;
+
+        if (isFrameParallelUsed_)
+        {
+            LOUDNESS_WARNING(name_ << ": Pipeline not used with frame "
+                    << "parallel processing.");
+            return;
+        }
+
+        vector<string> stageOutputs = pipelineStageOutputs_;
+        if (stageOutputs.empty())
+        {
+            for (const auto &outputName : {"Excitation", "SpecificLoudness",
+                    "InstantaneousLoudness"})
+            {
+                if (outputModules_.count(outputName))
+                    stageOutputs.push_back(outputName);
+            }
+        }
+
+        //stages are created in processing order
+        for (auto &module : modules_)
+        {
+            bool isStageOutput = false;
+            for (const auto &outputName : stageOutputs)
+            {
+                auto search = outputModules_.find(outputName);
+                if (search != outputModules_.end() && search -> second == module.get())
+                    isStageOutput = true;
+            }
+
+            vector<Module*> targets = module -> getTargetModules();
+            if (!isStageOutput || targets.empty())
+                continue;
+
+            LOUDNESS_DEBUG(name_ << ": New pipeline stage after "
+                    << module -> getName());
+            PipelineStage* stage = new PipelineStage(pipelineQueueDepth_,
+                    threadSpinTime_);
+            for (auto target : targets)
+            {
+                stage -> addTargetModule(*target);
+                module -> removeLastTargetModule();
+            }
+            module -> addTargetModule(*stage);
+            pipelineStages_.push_back(stage);
+        }
+
+        //owned by the model, added after the loop to keep iterators valid
+        for (auto stage : pipelineStages_)
+            modules_.push_back(unique_ptr<Module> (stage));
+
+        for (const auto &outputName : pipelineStageOutputs_)
+        {
+            if (!outputModules_.count(outputName))
+            {
+                LOUDNESS_WARNING(name_ << ": Unknown pipeline stage output : "
+                        << outputName);
+            }
+        }
+    }
+
+    void Model::configureFrameParallel(const SignalBank &input)
+    {
+        if (!isFrameParallelUsed_)
+            return;
+
+        std::map<Module*, int> moduleIdx;
+        for (int i = 0; i < (int)modules_.size(); ++i)
+            moduleIdx[modules_[i].get()] = i;
+
+        if (modules_[0] -> isStateless())
+        {
+            LOUDNESS_WARNING(name_ << ": No stateful front end, "
+                    << "frame parallel processing not used.");
+            return;
+        }
+
+        /*
+         * Phase 1: stateful modules from the root. Their stateless targets
+         * start the stateless section, which must hang off a single module.
+         */
+        frameSource_ = nullptr;
+        vector<Module*> frontEnd {modules_[0].get()}, statelessRoots;
+        for (uint i = 0; i < frontEnd.size(); ++i)
+        {
+            for (auto target : frontEnd[i] -> getTargetModules())
+            {
+                if (!target -> isStateless())
+                {
+                    frontEnd.push_back(target);
+                }
+                else if (!frameSource_ || (frameSource_ == frontEnd[i]))
+                {
+                    frameSource_ = frontEnd[i];
+                    statelessRoots.push_back(target);
+                }
+                else
+                {
+                    LOUDNESS_WARNING(name_ << ": Stateless section has more "
+                            << "than one source, frame parallel processing not used.");
+                    return;
+                }
+            }
+        }
+
+        if (!frameSource_)
+        {
+            LOUDNESS_WARNING(name_ << ": No stateless section, "
+                    << "frame parallel processing not used.");
+            return;
+        }
+
+        /*
+         * Phase 2: the stateless section. Phase 3: stateful targets of the
+         * stateless section, processed sequentially with their subtrees.
+         */
+        vector<Module*> stateless = statelessRoots;
+        for (uint i = 0; i < stateless.size(); ++i)
+        {
+            for (auto target : stateless[i] -> getTargetModules())
+            {
+                if (target -> isStateless() && std::find(stateless.begin(),
+                            stateless.end(), target) == stateless.end())
+                    stateless.push_back(target);
+            }
+        }
+
+        std::sort(stateless.begin(), stateless.end(),
+                [&moduleIdx](Module* a, Module* b){
+                    return moduleIdx[a] < moduleIdx[b];});
+
+        //outputs of the stateless section needed by the back end or user
+        statelessRootIdx_.clear();
+        replayIdx_.clear();
+        replayTargets_.clear();
+        for (auto module : statelessRoots)
+            statelessRootIdx_.push_back(moduleIdx[module]);
+        for (auto module : stateless)
+        {
+            vector<Module*> backEnd;
+            for (auto target : module -> getTargetModules())
+            {
+                if (!target -> isStateless())
+                    backEnd.push_back(target);
+            }
+
+            bool isOutput = module -> isOutputAggregated();
+            for (const auto &output : outputModules_)
+                isOutput = isOutput || (output.second == module);
+
+            if (isOutput || !backEnd.empty())
+            {
+                replayIdx_.push_back(moduleIdx[module]);
+                replayTargets_.push_back(backEnd);
+            }
+        }
+
+        //workers: clones processing the stateless section only
+        if (!threadPool_ || (nThreads_ > 0 && threadPool_ -> getNThreads() != nThreads_))
+            threadPool_.reset(new ThreadPool(nThreads_, threadSpinTime_));
+
+        for (int w = 0; w < threadPool_ -> getNThreads(); ++w)
+        {
+            unique_ptr<Model> worker (copyConfiguration());
+            if (!worker)
+            {
+                LOUDNESS_WARNING(name_ << ": Model cannot be cloned, "
+                        << "frame parallel processing not used.");
+                frameWorkers_.clear();
+                return;
+            }
+            worker -> setFrameParallelUsed(false);
+            worker -> setPipelineUsed(false);
+            worker -> setParallelBranchesUsed(false);
+            worker -> setParallelSlicesUsed(false);
+            worker -> setParallelChannelsUsed(false);
+            worker -> setOutputsToAggregate(vector<string>());
+            worker -> setOutputsToDescribe(vector<string>());
+            worker -> initialize(input);
+
+            for (auto module : stateless)
+            {
+                Module* workerModule = worker -> modules_[moduleIdx[module]].get();
+                LOUDNESS_ASSERT(workerModule -> getName() == module -> getName());
+                vector<Module*> targets = workerModule -> getTargetModules();
+                for (uint i = 0; i < targets.size(); ++i)
+                    workerModule -> removeLastTargetModule();
+                for (auto target : targets)
+                {
+                    if (target -> isStateless())
+                        workerModule -> addTargetModule(*target);
+                }
+            }
+            frameWorkers_.push_back(std::move(worker));
+        }
+
+        //detach the stateless section from the front end
+        vector<Module*> targets = frameSource_ -> getTargetModules();
+        for (uint i = 0; i < targets.size(); ++i)
+            frameSource_ -> removeLastTargetModule();
+        for (auto target : targets)
+        {
+            if (!target -> isStateless())
+                frameSource_ -> addTargetModule(*target);
+        }
+
+        frames_.assign(frameParallelBlockSize_, frameSource_ -> getOutput());
+        frameResults_.clear();
+        heldOutputs_.clear();
+        for (int idx : replayIdx_)
+        {
+            const SignalBank& output = modules_[idx] -> getOutput();
+            frameResults_.push_back(vector<SignalBank>
+                    (frameParallelBlockSize_, output));
+            heldOutputs_.push_back(output);
+        }
+
+        nBufferedFrames_ = 0;
+        isFrameParallelActive_ = true;
+        LOUDNESS_DEBUG(name_ << ": Frame parallel processing with "
+                << frameWorkers_.size() << " workers after "
+                << frameSource_ -> getName());
+    }
+
+    void Model::processFrameBlock()
+    {
+        int nFrames = nBufferedFrames_;
+        int nWorkers = (int)frameWorkers_.size();
+        int nReplays = (int)replayIdx_.size();
+
+        //phase 2: contiguous blocks of frames per worker
+        threadPool_ -> parallelFor(nWorkers, [&](int w)
+        {
+            Model& worker = *frameWorkers_[w];
+            int end = ((w + 1) * nFrames) / nWorkers;
+            for (int frame = (w * nFrames) / nWorkers; frame < end; ++frame)
+            {
+                if (!frames_[frame].getTrig())
+                    continue;
+
+                for (int idx : statelessRootIdx_)
+                    worker.modules_[idx] -> process(frames_[frame]);
+
+                for (int r = 0; r < nReplays; ++r)
+                {
+                    const SignalBank& output = worker.modules_[replayIdx_[r]]
+                                               -> getOutput();
+                    frameResults_[r][frame].copySamples(output);
+                    frameResults_[r][frame].setTrig(output.getTrig());
+                }
+            }
+        });
+
+        //phase 3: replay in order and run the back end
+        for (int frame = 0; frame < nFrames; ++frame)
+        {
+            for (int r = 0; r < nReplays; ++r)
+            {
+                Module* module = modules_[replayIdx_[r]].get();
+                if (frames_[frame].getTrig())
+                {
+                    module -> replayOutput(frameResults_[r][frame]);
+                }
+                else
+                {
+                    //untriggered: the previous output is passed on
+                    heldOutputs_[r].copySamples(module -> getOutput());
+                    heldOutputs_[r].setTrig(false);
+                    module -> replayOutput(heldOutputs_[r]);
+                }
+
+                for (auto target : replayTargets_[r])
+                    target -> process(module -> getOutput());
+            }
+        }
+
+        nBufferedFrames_ = 0;
+    }
+
+    void Model::setFrameParallelUsed(bool isFrameParallelUsed)
+    {
+        isFrameParallelUsed_ = isFrameParallelUsed;
+    }
+
+    void Model::setFrameParallelBlockSize(int frameParallelBlockSize)
+    {
+        frameParallelBlockSize_ = max(frameParallelBlockSize, 1);
+    }
+
+    bool Model::isFrameParallelActive() const
+    {
+        return isFrameParallelActive_;
+    }
+
+    void Model::setPipelineUsed(bool isPipelineUsed)
+    {
+        isPipelineUsed_ = isPipelineUsed;
+    }
+
+    void Model::setPipelineStageOutputs(const vector<string>& pipelineStageOutputs)
+    {
+        pipelineStageOutputs_ = pipelineStageOutputs;
+    }
+
+    void Model::setPipelineQueueDepth(int pipelineQueueDepth)
+    {
+        pipelineQueueDepth_ = pipelineQueueDepth;
+    }
+
+    int Model::getNPipelineStages() const
+    {
+        return (int)pipelineStages_.size() + 1;
+    }
+
+    void Model::collectSubtree(Module* module, vector<Module*>& subtree) const
+    {
+        subtree.push_back(module);
+        for (auto target : module -> getTargetModules())
+            collectSubtree(target, subtree);
+    }
+
+    void Model::configureParallelProcessing()
+    {
+        nParallelBranchPoints_ = 0;
+        bool isModuleParallel = areParallelSlicesUsed_ || areParallelChannelsUsed_;
+        if (!areParallelBranchesUsed_ && !isModuleParallel)
+            return;
+
+        vector<Module*> branchPoints;
+        for (auto &module : modules_)
+        {
+            if (!areParallelBranchesUsed_)
+                break;
+
+            const vector<Module*>& targets = module -> getTargetModules();
+            if (targets.size() < 2)
+                continue;
+
+            vector<Module*> allModules;
+            int nLargeBranches = 0;
+            for (auto target : targets)
+            {
+                vector<Module*> subtree;
+                collectSubtree(target, subtree);
+                if (subtree.size() > 1)
+                    nLargeBranches++;
+                allModules.insert(allModules.end(), subtree.begin(), subtree.end());
+            }
+
+            //branches must not share modules
+            std::sort(allModules.begin(), allModules.end());
+            bool isShared = std::adjacent_find(allModules.begin(),
+                    allModules.end()) != allModules.end();
+
+            if (isShared)
+            {
+                LOUDNESS_DEBUG(name_ << ": Branches of " << module -> getName()
+                        << " share modules, processing sequentially.");
+            }
+            else if (nLargeBranches > 1)
+            {
+                branchPoints.push_back(module.get());
+            }
+        }
+
+        if (branchPoints.empty() && !isModuleParallel)
+            return;
+
+        if (!threadPool_ || (nThreads_ > 0 && threadPool_ -> getNThreads() != nThreads_))
+            threadPool_.reset(new ThreadPool(nThreads_, threadSpinTime_));
+
+        for (auto module : branchPoints)
+        {
+            LOUDNESS_DEBUG(name_ << ": Processing targets of "
+                    << module -> getName() << " in parallel.");
+            module -> setThreadPool(threadPool_.get());
+            module -> setTargetModulesProcessedInParallel(true);
+        }
+        nParallelBranchPoints_ = (int)branchPoints.size();
+
+        if (isModuleParallel)
+        {
+            for (auto &module : modules_)
+            {
+                module -> setThreadPool(threadPool_.get());
+                module -> setSlicesProcessedInParallel(areParallelSlicesUsed_);
+                module -> setChannelsProcessedInParallel(areParallelChannelsUsed_);
+            }
+        }
+    }
+
+    void Model::setParallelBranchesUsed(bool areParallelBranchesUsed)
+    {
+        areParallelBranchesUsed_ = areParallelBranchesUsed;
+    }
+
+    void Model::setParallelSlicesUsed(bool areParallelSlicesUsed)
+    {
+        areParallelSlicesUsed_ = areParallelSlicesUsed;
+    }
+
+    void Model::setParallelChannelsUsed(bool areParallelChannelsUsed)
+    {
+        areParallelChannelsUsed_ = areParallelChannelsUsed;
+    }
+
+    void Model::setThreadSpinTime(Real threadSpinTime)
+    {
+        threadSpinTime_ = threadSpinTime;
+        if (threadPool_)
+            threadPool_ -> setSpinTime(threadSpinTime_);
+    }
+
+    void Model::setNThreads(int nThreads)
+    {
+        nThreads_ = nThreads;
+    }
+
+    int Model::getNParallelBranchPoints() const
+    {
+        return nParallelBranchPoints_;
+    }
+
     const string& Model::getName() const
     {
         return name_;
@@ -21,9 +21,14 @@
 #define MODEL_H
 
 #include "Module.h"
+#include "ThreadPool.h"
+#include <functional>
 
 namespace loudness{
 
+    class PipelineStage;
+    class FrameGate;
+
     /**
      * @class Model 
      * 
@@ -55,6 +60,79 @@ namespace loudness{
      * can use addOutputToAggregate() and removeOutputToAggregate() to add and
      * remove individual output modules from the aggregation list.
      *
+     * Scalar descriptors (mean, max, percentiles etc.) of an output can be
+     * tracked throughout processing by passing its name to
+     * setOutputsToDescribe(). A LoudnessDescriptors module is then attached
+     * to the output module and its result is available via getOutput() using
+     * the key <outputName>Descriptors.
+     *
+     * Models such as DynamicLoudnessCH2012 branch into several chains of
+     * modules which process the same SignalBank (e.g. the target and masker
+     * excitation patterns used for partial loudness). Calling
+     * setParallelBranchesUsed() before initialize() allows these independent
+     * branches to be processed concurrently on a ThreadPool owned by the
+     * model. After the derived model has connected its modules, the module
+     * graph is analysed and a branch point is only parallelised if its target
+     * subtrees share no modules and at least two of them contain more than one
+     * module (so that small branches such as descriptors do not pay for
+     * thread synchronisation). Each module still processes its input in
+     * the same order with the same data, so the output is identical to
+     * sequential processing.
+     *
+     * Similarly, setParallelSlicesUsed() allows modules to process each
+     * (source, ear) slice of their input concurrently on the same pool (see
+     * Module::processSlices()). For a single stream at a high frame rate,
+     * setParallelChannelsUsed() splits the channels of filter bank style
+     * modules across the pool (see Module::processChannels()). Idle threads
+     * spin before parking so that a new frame rarely needs to wake them; for
+     * real-time streaming set setThreadSpinTime() to about the hop period.
+     *
+     * For offline or buffered processing, setPipelineUsed() splits the module
+     * graph into stages which run on their own threads, so that consecutive
+     * hops are processed by different stages at the same time. A
+     * PipelineStage is inserted after each output named by
+     * setPipelineStageOutputs() (by default Excitation, SpecificLoudness and
+     * InstantaneousLoudness, where available). process() then returns before
+     * the downstream modules have processed the input, so call synchronize()
+     * before reading outputs (AudioFileProcessor::processAllFrames() does
+     * this). Outputs are best collected by aggregation.
+     *
+     * Offline, setFrameParallelUsed() exploits the fact that most modules
+     * are stateless (see Module::isStateless()). Hops are buffered in blocks
+     * and processed in three phases: the stateful front end (e.g. filters
+     * and FrameGenerator) runs sequentially, the stateless modules (spectrum
+     * to instantaneous loudness) process the frames of the block in
+     * parallel on clones of the model, and finally the results are replayed
+     * into this model and the stateful back end (e.g. ARAverager) runs
+     * sequentially. The output is identical to streaming. As with the
+     * pipeline, call synchronize() before reading outputs.
+     *
+     * For material with long silences or sustained sounds,
+     * setFrameSkippingUsed() inserts a FrameGate after the WeightedSpectrum
+     * output. Silent frames and frames whose spectrum is within a relative
+     * tolerance of the last fully processed one are flagged as unchanged, and
+     * the stateless modules that follow (excitation, specific loudness,
+     * binaural inhibition) reuse their previous output. Stateful modules, e.g.
+     * temporal integration, still process every frame. See FrameGate for the
+     * deviation this introduces and getNSkippedSteadyFrames() and
+     * getNSkippedSilentFrames() for the counters.
+     *
+     * Dual-mono input can be processed at about half the cost with
+     * setEarMirroringUsed(). The first stateless module after the stateful
+     * front end (e.g. Window after FrameGenerator) compares the ears of each
+     * frame; if they are identical, the spectrum, excitation and specific
+     * loudness are computed for one ear and copied to the other, and binaural
+     * inhibition reduces to a constant gain (see Module::mirrorEars()). With
+     * a tolerance of zero (default) the output is identical to processing
+     * both ears.
+     *
+     * Different models can be initialised and processed on different
+     * threads at the same time: the FFTW planner is serialised (see FFT) and
+     * tables shared between models are immutable (see TableRegistry). A
+     * single model, including the modules it owns, must only be used by one
+     * thread at a time. The Python bindings release the GIL during
+     * initialisation and processing.
+     *
      * @author Dominic Ward
      *
      * @sa Module
@@ -72,6 +150,21 @@ namespace loudness{
         Model(string name = "Model", bool isDynamic = true);
         virtual ~Model();
 
+        /**
+        * @brief Returns a new model with the same configuration as this one.
+        * The caller owns the returned model.
+        *
+        * If this model is initialised, so is the clone, and its state is
+        * reset. The modules are then copied (see Module::clone()) rather
+        * than initialised again, so coefficients are not reloaded and FFT
+        * plans are shared. If a module cannot be copied (or the model is
+        * pipelined or frame parallel), the clone is initialised with an
+        * input of the same shape as the one used to initialise this model.
+        *
+        * Returns nullptr if the derived model does not support cloning.
+        */
+        Model* clone() const;
+
         /**
         * @brief Initialises the model and all associated modules.
         *
@@ -93,11 +186,75 @@ namespace loudness{
         */
         void process(const SignalBank &input);
 
+        /**
+        * @brief Processes nHops consecutive hops of input in one call.
+        *
+        * input must have the same number of sources, ears and channels as
+        * the SignalBank used to initialise the model, and at least nHops
+        * times as many samples. Each hop is processed as by process() and
+        * the outputs named by setBlockOutputs() are collected in blocks of
+        * nHops rows, available from getBlockOutput(). This saves a call per
+        * hop from Python and, with setFrameParallelUsed(), the stateless
+        * modules process the frames of the block concurrently. The model
+        * is synchronised before returning.
+        *
+        * @return true if the block was processed, false otherwise.
+        */
+        bool processBlock(const SignalBank &input, int nHops);
+
+        /**
+        * @brief Processes a whole signal as a single block (see
+        * processBlock()).
+        *
+        * signal holds nSamples samples for each source and ear, source by
+        * source and ear by ear, matching the SignalBank used to initialise
+        * the model (which must have a single channel). nSamplesToPadStart
+        * zeros are processed before the signal and at least
+        * nSamplesToPadEnd zeros after it, completing the final hop. Hops
+        * are read straight from signal.
+        *
+        * Outputs named in outputBuffers are written hop by hop into the
+        * caller-owned buffer, which must hold getNSignalHops() output
+        * SignalBanks, and are not available from getBlockOutput(). They
+        * need not be block outputs (see setBlockOutputs()).
+        *
+        * @return The number of hops processed, 0 on failure.
+        */
+        int processSignal(const Real* signal, int nSources, int nEars,
+                int nSamples, int nSamplesToPadStart = 0,
+                int nSamplesToPadEnd = 0,
+                const map<string, Real*>& outputBuffers =
+                map<string, Real*>());
+
+        /** Returns the number of hops processSignal() processes for a
+         * signal of nSamples samples and the given padding. */
+        int getNSignalHops(int nSamples, int nSamplesToPadStart = 0,
+                int nSamplesToPadEnd = 0) const;
+
+        /** Sets the names of the outputs collected by processBlock(). */
+        void setBlockOutputs(const vector<string>& blockOutputs);
+
+        /** Returns the block of an output collected by the last call to
+         * processBlock(). The aggregated signals hold one output SignalBank
+         * per hop (see SignalBank::getAggregatedSignals()). */
+        const SignalBank& getBlockOutput(const string& outputName) const;
+
+        /** Returns the names of the outputs collected by the last call to
+         * processBlock(). */
+        vector<string> getBlockOutputNames() const;
+
         /**
         * @brief Resets all modules. The output SignalBanks are also cleared.
         */
         void reset();
 
+        /**
+        * @brief Waits until all pipeline stages have processed their queued
+        * frames and processes any hops buffered for frame parallel
+        * processing. Does nothing if neither is used.
+        */
+        void synchronize();
+
         /** A vector of output names corresponding to the modules whose output
          * will be aggregated. */
         void setOutputsToAggregate(const vector<string>& outputToAggregate);
@@ -112,6 +269,100 @@ namespace loudness{
          * with the module mapped to the name outputToAggregate. */
         void removeOutputToAggregate(string& outputToAggregate);
 
+        /** A vector of output names whose signals will be summarised by a
+         * LoudnessDescriptors module. The descriptors are accessed using the
+         * output name <outputName>Descriptors. Call this before
+         * initialize(). */
+        void setOutputsToDescribe(const vector<string>& outputsToDescribe);
+
+        /** Set to true to process independent branches of the module graph
+         * in parallel. Call this before initialize(). */
+        void setParallelBranchesUsed(bool areParallelBranchesUsed);
+
+        /** Set to true to let modules process their (source, ear) slices in
+         * parallel. This benefits multi-source (partial loudness) and stereo
+         * configurations. Call this before initialize(). */
+        void setParallelSlicesUsed(bool areParallelSlicesUsed);
+
+        /** Set to true to let modules split their output channels across
+         * threads. This benefits a single stream processed at high
+         * resolution. Call this before initialize(). */
+        void setParallelChannelsUsed(bool areParallelChannelsUsed);
+
+        /** Sets the time in seconds an idle thread, of the thread pool or of
+         * a pipeline stage, spins waiting for work before parking (default
+         * 0.0002). */
+        void setThreadSpinTime(Real threadSpinTime);
+
+        /** Set to true to process the model as a pipeline of stages, each on
+         * its own thread. Call this before initialize(). */
+        void setPipelineUsed(bool isPipelineUsed);
+
+        /** Sets the output names after which a new pipeline stage starts. */
+        void setPipelineStageOutputs(const vector<string>& pipelineStageOutputs);
+
+        /** Sets the maximum number of frames queued between two stages. */
+        void setPipelineQueueDepth(int pipelineQueueDepth);
+
+        /** Set to true to process blocks of hops in three phases, with the
+         * stateless modules processing frames in parallel. Call this before
+         * initialize(). */
+        void setFrameParallelUsed(bool isFrameParallelUsed);
+
+        /** Sets the number of hops processed per block in frame parallel
+         * mode (default 1024). */
+        void setFrameParallelBlockSize(int frameParallelBlockSize);
+
+        /** Returns true if frame parallel processing is in use after
+         * initialisation, false otherwise (e.g. not requested or the model
+         * has no stateless section). */
+        bool isFrameParallelActive() const;
+
+        /** Returns the number of pipeline stages (1 if not pipelined). */
+        int getNPipelineStages() const;
+
+        /** Set to true to skip the excitation and specific loudness stages
+         * for silent and steady frames (see FrameGate). Call this before
+         * initialize(). */
+        void setFrameSkippingUsed(bool isFrameSkippingUsed);
+
+        /** Sets the total power in dB of the weighted spectrum below which a
+         * frame is silent (default -20). Use -inf to disable. */
+        void setSilenceThreshold(Real silenceThresholdInDB);
+
+        /** Sets the relative tolerance below which the weighted spectrum of
+         * a frame is steady (default 0.01). Use 0 to disable. */
+        void setSteadyStateTolerance(Real steadyStateTolerance);
+
+        /** Set to true to process identical ears of each frame once and copy
+         * the result to the other ear. Call this before initialize(). */
+        void setEarMirroringUsed(bool isEarMirroringUsed);
+
+        /** Sets the tolerance, relative to the peak magnitude of the first
+         * ear, within which ears are considered identical (default 0, i.e.
+         * numerically equal). */
+        void setEarMirroringTolerance(Real earMirroringTolerance);
+
+        /** Returns the number of frames seen by the frame gate since
+         * initialisation, or 0 if frame skipping is not used. If pipelined,
+         * call synchronize() first. The counters of a ModelEnsemble sum over
+         * the gates of its distinct weighted spectra. */
+        long long getNGatedFrames() const;
+
+        /** Returns the number of silent frames skipped. */
+        long long getNSkippedSilentFrames() const;
+
+        /** Returns the number of steady frames skipped. */
+        long long getNSkippedSteadyFrames() const;
+
+        /** Sets the total number of threads (including the caller) used for
+         * parallel processing. If less than 1 (the default), the number of
+         * hardware threads is used. Call this before initialize(). */
+        void setNThreads(int nThreads);
+
+        /** Returns the number of branch points processed in parallel. */
+        int getNParallelBranchPoints() const;
+
         /** Sets the processing rate in Hz for a dynamic loudness
          * model. Note that after initialisation, the true processing rate will
          * be dependent on the sampling frequency and the input buffer size.
@@ -142,6 +393,74 @@ namespace loudness{
          */
         const SignalBank& getOutput(const string& outputName) const;
 
+        /** Returns true if outputName names an output of the model. */
+        bool hasOutput(const string& outputName) const;
+
+        /** Returns the names of the outputs being aggregated. */
+        vector<string> getAggregatedOutputNames() const;
+
+        /** Replaces the aggregated signals of an output, e.g. with results
+         * stitched together from several models. */
+        void setAggregatedOutput(const string& outputName,
+                const RealVec& aggregatedSignals);
+
+        /**
+        * @brief Sets the output SignalBank of outputName to output, as if
+        * computed by its module, and processes the modules downstream of it
+        * with it. The upstream modules are not processed.
+        *
+        * This allows the later stages of a model to be driven by stored or
+        * modified intermediate results (see LoudnessGainSolver). Not
+        * available with frame parallel processing. If pipelined, call
+        * synchronize() before reading outputs.
+        *
+        * @return true if replayed, false otherwise.
+        */
+        bool replayOutput(const string& outputName, const SignalBank& output);
+
+        /** Resets the modules downstream of outputName, but not the module
+         * producing it. */
+        void resetDownstream(const string& outputName);
+
+        /** Returns a hash of the module names, configurations (see
+         * Module::hashConfiguration()) and output structures from the input
+         * up to and including the module producing outputName.
+         * Changes downstream of it leave the hash unchanged (see
+         * StageCheckpoint). The model must be initialised. */
+        unsigned long long getUpstreamHash(const string& outputName) const;
+
+        /**
+        * @brief Returns the dynamic state of the model, e.g. to resume a
+        * stream on another model or after a restart.
+        *
+        * Only modules carrying state from one hop to the next (see
+        * Module::isStateless()) are saved: filter delay lines, frame
+        * buffers, resonators, integrators and so on. The outputs of
+        * stateless modules are recomputed on the next triggered hop, except
+        * after a FrameGate (see setFrameSkippingUsed()) where skipped frames
+        * reuse them. Aggregated outputs are not included. Buffered hops and queued
+        * frames are processed first (see synchronize()).
+        *
+        * The state starts with a format version and a hash of the model
+        * configuration (module names and output structures), so it can
+        * only be loaded into a model configured in the same way, with or
+        * without pipelining and frame parallel processing.
+        *
+        * Returns an empty vector if the model is not initialised.
+        */
+        RealVec saveState();
+
+        /**
+        * @brief Restores the state returned by saveState(). Processing then
+        * continues exactly as it would have on the saved model.
+        *
+        * Buffered hops are discarded. If the state does not match the
+        * configuration of this model, the model is reset.
+        *
+        * @return true if the state was restored, false otherwise.
+        */
+        bool loadState(const RealVec& state);
+
         /**
          * @brief Returns the number of initialised modules comprising the
          * model.
@@ -154,22 +473,124 @@ namespace loudness{
         const string& getName() const;
 
     protected:
+        /** Copies the configuration, but not the modules, of other. */
+        Model(const Model& other);
+
+        /** Returns a new, uninitialised model with the same configuration
+         * as this one, normally using the copy constructor of the derived
+         * model. The default returns nullptr. */
+        virtual Model* copyConfiguration() const;
+
+        /** Copies the initialised modules of other, redirecting targets and
+         * outputs to the copies. Returns false if any module cannot be
+         * copied. */
+        bool cloneModules(const Model& other);
+
+        /** Builds the module graph of model for input and moves its modules
+         * into this model, exposing each output under outputPrefix followed
+         * by the output name. Returns the root module, or nullptr if model
+         * cannot be initialised. */
+        Module* adoptModules(Model& model, const SignalBank &input,
+                const string& outputPrefix);
+
+        /** Returns the options of model which apply to the model as a whole,
+         * such as descriptors, frame skipping and ear mirroring. These are
+         * not applied by adoptModules(). */
+        vector<string> getModelOptionsInUse(const Model& model) const;
+
         virtual bool initializeInternal(const SignalBank &input) = 0;
 
         /** Sets each modules in the chain to be the target of it's
          * predecessor. */
         void configureLinearTargetModuleChain(int = 0);
 
+        /**
+         * @brief Appends a fused temporal integration stage, such as a
+         * LoudnessIntegrator, as a target of the last module.
+         *
+         * Channel 0, 1 and 2 of its output are exposed as
+         * "Instantaneous<loudnessName>", "ShortTerm<loudnessName>" and
+         * "LongTerm<loudnessName>" using ChannelSelector modules. The model
+         * takes ownership of integrator.
+         */
+        void configureTemporalIntegration(Module* integrator,
+                const string& loudnessName);
+
         /** Informs modules to aggregate the output SignalBank. */
         void configureSignalBankAggregation();
 
+        /** Attaches a LoudnessDescriptors module to each output to describe. */
+        void configureOutputDescriptors();
+
+        /** Marks branch points whose target subtrees can be processed
+         * concurrently and, if requested, enables parallel slice or channel
+         * processing in all modules. All share the thread pool. */
+        void configureParallelProcessing();
+
+        /** Inserts a PipelineStage after each pipeline stage output. */
+        void configurePipelineStages();
+
+        /** Inserts a FrameGate after each distinct WeightedSpectrum output,
+         * including the prefixed outputs of a ModelEnsemble. */
+        void configureFrameSkipping();
+
+        /** Enables ear comparison on the first stateless module of each path
+         * from module. */
+        void configureEarMirroring(Module* module);
+
+        /** Splits the module graph into the front end, stateless section
+         * and back end and sets up the clones used for frame parallel
+         * processing. */
+        void configureFrameParallel(const SignalBank &input);
+
+        /** Processes nHops hops, each loaded into input_ by loadHop, and
+         * collects the outputs in outputNames (see processBlock()). */
+        bool processHops(int nHops, const std::function<void(int)>& loadHop,
+                const vector<string>& outputNames,
+                const map<string, Real*>& outputBuffers);
+
+        /** Processes the buffered hops in three phases. */
+        void processFrameBlock();
+
+        /** Appends module and all modules reachable from it to subtree. */
+        void collectSubtree(Module* module, vector<Module*>& subtree) const;
+
+        /** Returns true if module is one of the pipeline stages. */
+        bool isPipelineStage(const Module& module) const;
+
+        /** Returns true if the state of module is saved by saveState(). */
+        bool isModuleStateSaved(const Module& module) const;
+
+        /** Returns a hash of the module names, configurations and output
+         * structures. */
+        unsigned long long getConfigurationHash() const;
+
         string name_;
-        bool isDynamic_, initialized_;
-        int nModules_;
-        Real rate_;
+        bool isDynamic_, initialized_, areParallelBranchesUsed_;
+        bool areParallelSlicesUsed_, areParallelChannelsUsed_, isPipelineUsed_;
+        bool isFrameParallelUsed_, isFrameParallelActive_, isFrameSkippingUsed_;
+        bool isEarMirroringUsed_;
+        int nModules_, nThreads_, nParallelBranchPoints_, pipelineQueueDepth_;
+        int frameParallelBlockSize_, nBufferedFrames_;
+        Real rate_, threadSpinTime_, silenceThresholdInDB_, steadyStateTolerance_;
+        Real earMirroringTolerance_;
+        SignalBank input_;
         vector<unique_ptr<Module>> modules_;
         map<string, Module*> outputModules_;
-        vector<string> outputsToAggregate_;
+        vector<string> outputsToAggregate_, outputsToDescribe_;
+        vector<string> pipelineStageOutputs_, blockOutputs_;
+        map<string, SignalBank> blockOutputBanks_;
+        vector<PipelineStage*> pipelineStages_;
+        vector<FrameGate*> frameGates_;
+
+        //frame parallel processing
+        Module* frameSource_;
+        vector<int> statelessRootIdx_, replayIdx_;
+        vector<vector<Module*>> replayTargets_;
+        vector<unique_ptr<Model>> frameWorkers_;
+        vector<SignalBank> frames_, heldOutputs_;
+        vector<vector<SignalBank>> frameResults_;
+        unique_ptr<ThreadPool> threadPool_;
     };
 }
 
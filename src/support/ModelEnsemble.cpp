@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelEnsemble.h"
+#include "../modules/ChannelSelector.h"
+
+namespace loudness{
+
+    ModelEnsemble::ModelEnsemble() :
+        Model("ModelEnsemble", true),
+        nSharedModules_(0)
+    {}
+
+    ModelEnsemble::ModelEnsemble(const ModelEnsemble& other) :
+        Model(other),
+        modelNames_(other.modelNames_),
+        nSharedModules_(0)
+    {
+        for (const auto &model : other.models_)
+            models_.push_back(unique_ptr<Model> (model -> clone()));
+    }
+
+    ModelEnsemble::~ModelEnsemble()
+    {}
+
+    Model* ModelEnsemble::copyConfiguration() const
+    {
+        for (const auto &model : models_)
+        {
+            if (!model)
+                return nullptr;
+        }
+        ModelEnsemble* ensemble = new ModelEnsemble(*this);
+        for (const auto &model : ensemble -> models_)
+        {
+            if (!model)
+            {
+                delete ensemble;
+                return nullptr;
+            }
+        }
+        return ensemble;
+    }
+
+    void ModelEnsemble::addModel(const Model& model, const string& name)
+    {
+        Model* copy = model.clone();
+        if (!copy)
+        {
+            LOUDNESS_ERROR(name_ << ": " << model.getName()
+                    << " cannot be copied.");
+            return;
+        }
+        models_.push_back(unique_ptr<Model> (copy));
+        modelNames_.push_back(name.empty() ? model.getName() : name);
+
+        vector<string> options = getModelOptionsInUse(model);
+        if (!options.empty())
+        {
+            string optionList = options[0];
+            for (uint i = 1; i < options.size(); ++i)
+                optionList += ", " + options[i];
+            LOUDNESS_WARNING(name_ << ": Ignoring the " << optionList
+                    << " of " << modelNames_.back() << "; set them on the "
+                    << "ensemble using prefixed output names.");
+        }
+    }
+
+    int ModelEnsemble::getNModels() const
+    {
+        return (int)models_.size();
+    }
+
+    int ModelEnsemble::getNSharedModules() const
+    {
+        return nSharedModules_;
+    }
+
+    void ModelEnsemble::mergeModules(Module* kept, Module* duplicate,
+            map<Module*, Module*>& replacements)
+    {
+        replacements[duplicate] = kept;
+        ++nSharedModules_;
+
+        //targets of the duplicate see the same input as those of kept
+        vector<Module*> keptTargets = kept -> getTargetModules();
+        for (auto target : duplicate -> getTargetModules())
+        {
+            Module* match = nullptr;
+            for (auto keptTarget : keptTargets)
+            {
+                if (keptTarget -> isEquivalentTo(*target))
+                {
+                    match = keptTarget;
+                    break;
+                }
+            }
+
+            if (match)
+                mergeModules(match, target, replacements);
+            else
+                kept -> addTargetModule(*target);
+        }
+    }
+
+    bool ModelEnsemble::initializeInternal(const SignalBank &input)
+    {
+        nSharedModules_ = 0;
+        if (models_.empty())
+        {
+            LOUDNESS_ERROR(name_ << ": No models to process.");
+            return 0;
+        }
+
+        for (uint i = 0; i < modelNames_.size(); ++i)
+        {
+            for (uint j = 0; j < i; ++j)
+            {
+                if (modelNames_[i] == modelNames_[j])
+                {
+                    LOUDNESS_ERROR(name_ << ": Duplicate model name "
+                            << modelNames_[i] << ".");
+                    return 0;
+                }
+            }
+        }
+
+        vector<Module*> roots;
+        for (uint i = 0; i < models_.size(); ++i)
+        {
+            Module* root = adoptModules(*models_[i], input,
+                    modelNames_[i] + ".");
+            if (!root)
+                return 0;
+            roots.push_back(root);
+        }
+
+        map<Module*, Module*> replacements;
+        vector<Module*> distinctRoots;
+        for (auto root : roots)
+        {
+            Module* match = nullptr;
+            for (auto distinctRoot : distinctRoots)
+            {
+                if (distinctRoot -> isEquivalentTo(*root))
+                {
+                    match = distinctRoot;
+                    break;
+                }
+            }
+
+            if (match)
+                mergeModules(match, root, replacements);
+            else
+                distinctRoots.push_back(root);
+        }
+
+        //shared modules are processed by the module they were merged into
+        for (auto &output : outputModules_)
+        {
+            auto search = replacements.find(output.second);
+            if (search != replacements.end())
+                output.second = search -> second;
+        }
+        modules_.erase(std::remove_if(modules_.begin(), modules_.end(),
+                    [&](const unique_ptr<Module>& module)
+                    {
+                        return replacements.count(module.get()) > 0;
+                    }), modules_.end());
+
+        if (distinctRoots.size() > 1)
+        {
+            Module* root = new ChannelSelector(0, input.getNChannels());
+            for (auto distinctRoot : distinctRoots)
+                root -> addTargetModule(*distinctRoot);
+            modules_.insert(modules_.begin(), unique_ptr<Module> (root));
+        }
+
+        LOUDNESS_DEBUG(name_ << ": " << nSharedModules_
+                << " modules shared by " << models_.size() << " models.");
+
+        return 1;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MODELENSEMBLE_H
+#define MODELENSEMBLE_H
+
+#include "Model.h"
+
+namespace loudness{
+
+    /**
+     * @class ModelEnsemble
+     *
+     * @brief Runs several loudness models on the same input, sharing the
+     * modules their graphs have in common.
+     *
+     * Each model added with addModel() builds its module graph as usual,
+     * then the graphs are merged from the root: two modules fed by the same
+     * SignalBank are shared if Module::isEquivalentTo() holds, i.e. they are
+     * of the same type and configuration, and this continues down their
+     * targets until the graphs diverge. A shared front end (e.g. filter,
+     * FrameGenerator, Window and PowerSpectrum) is thus processed once per
+     * hop and fans out to the back end of each model. The outputs of each
+     * model are identical to those of the model on its own.
+     *
+     * The outputs of a model are available under the name of the model
+     * followed by a dot and the output name, e.g.
+     * "DynamicLoudnessGM2002.ShortTermLoudness". These names are also used
+     * by setOutputsToAggregate(), setPipelineStageOutputs() and the other
+     * output based options of Model.
+     *
+     * Sharing requires identical configurations, so the front ends of the
+     * default models often differ: DynamicLoudnessGM2002 applies a middle
+     * ear high-pass filter which DynamicLoudnessCH2012 does not, and the two
+     * use different band edges and windows (see
+     * DynamicLoudnessCH2012::setWindowSpecGM02()). getNSharedModules()
+     * reports how many modules were saved. If the roots of the models
+     * differ, a ChannelSelector passing the input through becomes the root;
+     * as it is stateless, frame parallel processing is not available then.
+     *
+     * The models are copied by addModel(), so configure them first. Only
+     * their module graphs are used: options of a model as a whole, such as
+     * descriptors, frame skipping, ear mirroring and parallel processing,
+     * are ignored with a warning and should be set on the ensemble instead.
+     * Frame skipping on the ensemble gates each distinct
+     * "<name>.WeightedSpectrum" output, so a shared weighted spectrum is
+     * gated once.
+     *
+     * @sa Model, Module::isEquivalentTo()
+     */
+    class ModelEnsemble : public Model
+    {
+    public:
+        ModelEnsemble();
+        virtual ~ModelEnsemble();
+
+        /**
+         * @brief Adds a copy of the configuration of model to the ensemble.
+         *
+         * @param model The model to add.
+         * @param name The prefix of its outputs. If empty, the name of the
+         * model is used.
+         */
+        void addModel(const Model& model, const string& name = "");
+
+        int getNModels() const;
+
+        /** Returns the number of modules shared by the last initialisation. */
+        int getNSharedModules() const;
+
+    private:
+        ModelEnsemble(const ModelEnsemble& other);
+        virtual Model* copyConfiguration() const;
+        virtual bool initializeInternal(const SignalBank &input);
+        void mergeModules(Module* kept, Module* duplicate,
+                map<Module*, Module*>& replacements);
+
+        vector<unique_ptr<Model>> models_;
+        vector<string> modelNames_;
+        int nSharedModules_;
+    };
+}
+
+#endif
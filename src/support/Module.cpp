@@ -18,19 +18,67 @@
  */
 
 #include "Module.h"
+#include "ThreadPool.h"
 
 namespace loudness{
+
+    namespace {
+
+        //true if all ears of each source match the first ear
+        bool compareEars(const SignalBank &input, Real tolerance)
+        {
+            if (input.getNEars() < 2)
+                return false;
+
+            int nSamples = input.getNTotalSamplesPerEar();
+            for (int src = 0; src < input.getNSources(); ++src)
+            {
+                const Real* first = input.getSignalReadPointer(src, 0, 0);
+                Real maxDiff = 0.0;
+                if (tolerance > 0)
+                {
+                    for (int i = 0; i < nSamples; ++i)
+                        maxDiff = max(maxDiff, fabs(first[i]));
+                    maxDiff *= tolerance;
+                }
+
+                for (int ear = 1; ear < input.getNEars(); ++ear)
+                {
+                    const Real* x = input.getSignalReadPointer(src, ear, 0);
+                    for (int i = 0; i < nSamples; ++i)
+                    {
+                        if (!(fabs(x[i] - first[i]) <= maxDiff))
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }
     
     Module::Module(const string& name) :
         name_(name),
         initialized_(false),
-        isOutputAggregated_(false)
+        isOutputAggregated_(false),
+        areTargetModulesProcessedInParallel_(false),
+        areSlicesProcessedInParallel_(false),
+        areChannelsProcessedInParallel_(false),
+        isEarComparisonUsed_(false),
+        areInputEarsIdentical_(false),
+        earTolerance_(0.0),
+        minChannelsPerTask_(256),
+        threadPool_(nullptr)
     {
         LOUDNESS_DEBUG(name_ << ": Constructed.");
     };
 
     Module::~Module(){};
 
+    Module* Module::clone() const
+    {
+        return nullptr;
+    }
+
     bool Module::initialize()
     {
         if(initialized_)
@@ -48,6 +96,7 @@ namespace loudness{
             LOUDNESS_DEBUG(name_ << ": Initialised.");
             if(output_.isInitialized())
             {
+                output_.shareCentreFreqs();
                 for (uint i = 0; i < targetModules_.size(); i++)
                     targetModules_[i] -> initialize(output_);
             }
@@ -75,6 +124,7 @@ namespace loudness{
             LOUDNESS_DEBUG(name_ << ": Initialised.");
             if(output_.isInitialized())
             {
+                output_.shareCentreFreqs();
                 for (uint i = 0; i < targetModules_.size(); i++)
                     targetModules_[i] -> initialize(output_);
             }
@@ -90,12 +140,14 @@ namespace loudness{
         {
             LOUDNESS_PROCESS_DEBUG(name_ << ": processing ...");
             output_.setTrig(true);
+            output_.setUnchanged(false);
+            output_.setEarsIdentical(false);
+            output_.setChangedChannels(0, output_.getNChannels());
             processInternal();
             if (isOutputAggregated_)
                 output_.aggregate();
 
-            for (uint i = 0; i < targetModules_.size(); i++)
-                targetModules_[i] -> process(output_);
+            processTargetModules();
         }
 
     }
@@ -107,9 +159,25 @@ namespace loudness{
 
             if (input.getTrig())
             {
-                LOUDNESS_PROCESS_DEBUG(name_ << ": processing SignalBank ...");
                 output_.setTrig(true);
-                processInternal(input);
+
+                //same input, same output
+                if (input.isUnchanged() && isStateless())
+                {
+                    LOUDNESS_PROCESS_DEBUG(name_ << ": input unchanged.");
+                    output_.setUnchanged(true);
+                }
+                else
+                {
+                    LOUDNESS_PROCESS_DEBUG(name_ << ": processing SignalBank ...");
+                    output_.setUnchanged(false);
+                    output_.setEarsIdentical(false);
+                    output_.setChangedChannels(0, output_.getNChannels());
+                    areInputEarsIdentical_ = input.areEarsIdentical() ||
+                        (isEarComparisonUsed_ && compareEars(input, earTolerance_));
+                    processInternal(input);
+                    areInputEarsIdentical_ = false;
+                }
             }
             else
             {
@@ -122,11 +190,125 @@ namespace loudness{
                 output_.aggregate();
             }
 
-            for (uint i = 0; i < targetModules_.size(); i++)
+            processTargetModules();
+        }
+    }
+
+    void Module::processTargetModules()
+    {
+        int nTargets = (int)targetModules_.size();
+        if (areTargetModulesProcessedInParallel_ && threadPool_ && (nTargets > 1))
+        {
+            threadPool_ -> parallelFor(nTargets, [this](int i){
+                    targetModules_[i] -> process(output_);});
+        }
+        else
+        {
+            for (int i = 0; i < nTargets; i++)
                 targetModules_[i] -> process(output_);
         }
     }
 
+    void Module::setEarComparisonUsed(bool isEarComparisonUsed,
+            Real earTolerance)
+    {
+        isEarComparisonUsed_ = isEarComparisonUsed;
+        earTolerance_ = earTolerance;
+    }
+
+    int Module::getNEarsToProcess(const SignalBank &input) const
+    {
+        return areInputEarsIdentical_ ? 1 : input.getNEars();
+    }
+
+    void Module::mirrorEars()
+    {
+        if (!areInputEarsIdentical_)
+            return;
+
+        int nSamples = output_.getNTotalSamplesPerEar();
+        for (int src = 0; src < output_.getNSources(); ++src)
+        {
+            const Real* first = output_.getSignalReadPointer(src, 0, 0);
+            for (int ear = 1; ear < output_.getNEars(); ++ear)
+            {
+                std::copy(first, first + nSamples,
+                        output_.getSignalWritePointer(src, ear, 0));
+            }
+        }
+        output_.setEarsIdentical(true);
+    }
+
+    void Module::processSlices(int nSources, int nEars,
+            const std::function<void(int, int, int)>& processSlice)
+    {
+        //identical ears: process the first, copy to the others
+        if (areInputEarsIdentical_ && (nEars > 1))
+        {
+            LOUDNESS_ASSERT(output_.getNEars() == nEars);
+            processSlices(nSources, 1, processSlice);
+            mirrorEars();
+            return;
+        }
+
+        int nSlices = nSources * nEars;
+        if (!areSlicesProcessedInParallel_ || !threadPool_ || (nSlices < 2))
+        {
+            for (int src = 0; src < nSources; ++src)
+            {
+                for (int ear = 0; ear < nEars; ++ear)
+                    processSlice(src, ear, 0);
+            }
+            return;
+        }
+
+        //batch small slices, but keep enough tasks to balance the load
+        int nChannels = max(output_.getNChannels() * output_.getNSamples(), 1);
+        int slicesPerTask = (minChannelsPerTask_ + nChannels - 1) / nChannels;
+        int nTasks = (nSlices + slicesPerTask - 1) / slicesPerTask;
+        nTasks = min(nTasks, 4 * threadPool_ -> getNThreads());
+        slicesPerTask = (nSlices + nTasks - 1) / nTasks;
+        nTasks = (nSlices + slicesPerTask - 1) / slicesPerTask;
+
+        threadPool_ -> parallelFor(nTasks, [&](int task)
+        {
+            int end = min((task + 1) * slicesPerTask, nSlices);
+            for (int slice = task * slicesPerTask; slice < end; ++slice)
+                processSlice(slice / nEars, slice % nEars, slice);
+        });
+    }
+
+    void Module::processChannels(int nChannels, int minChannelsPerTask,
+            const std::function<void(int, int)>& processRange)
+    {
+        int nTasks = 1;
+        if (areChannelsProcessedInParallel_ && threadPool_)
+        {
+            nTasks = nChannels / max(minChannelsPerTask, 1);
+            nTasks = max(min(nTasks, threadPool_ -> getNThreads()), 1);
+        }
+
+        if (nTasks == 1)
+        {
+            processRange(0, nChannels);
+            return;
+        }
+
+        threadPool_ -> parallelFor(nTasks, [&](int task)
+        {
+            processRange((task * nChannels) / nTasks,
+                    ((task + 1) * nChannels) / nTasks);
+        });
+    }
+
+    int Module::getNSlices(int nSources, int nEars) const
+    {
+        if (areSlicesProcessedInParallel_)
+            return nSources * nEars;
+        else
+            return 1;
+    }
+
     void Module::reset()
     {
         //clear output signal
@@ -152,6 +334,42 @@ namespace loudness{
         targetModules_.pop_back();
     }
 
+    void Module::setThreadPool(ThreadPool* threadPool)
+    {
+        threadPool_ = threadPool;
+    }
+
+    void Module::setTargetModulesProcessedInParallel(
+            bool areTargetModulesProcessedInParallel)
+    {
+        areTargetModulesProcessedInParallel_ = areTargetModulesProcessedInParallel;
+    }
+
+    void Module::setSlicesProcessedInParallel(bool areSlicesProcessedInParallel)
+    {
+        areSlicesProcessedInParallel_ = areSlicesProcessedInParallel;
+    }
+
+    bool Module::areSlicesProcessedInParallel() const
+    {
+        return areSlicesProcessedInParallel_;
+    }
+
+    void Module::setChannelsProcessedInParallel(bool areChannelsProcessedInParallel)
+    {
+        areChannelsProcessedInParallel_ = areChannelsProcessedInParallel;
+    }
+
+    bool Module::areChannelsProcessedInParallel() const
+    {
+        return areChannelsProcessedInParallel_;
+    }
+
+    const vector<Module*>& Module::getTargetModules() const
+    {
+        return targetModules_;
+    }
+
     void Module::setOutputAggregated(bool isOutputAggregated)
     {
         isOutputAggregated_ = isOutputAggregated;
@@ -176,5 +394,100 @@ namespace loudness{
     {
         return name_;
     }
-}
 
+    bool Module::isStateless() const
+    {
+        return false;
+    }
+
+    void Module::setAggregatedOutput(const RealVec &aggregatedSignals)
+    {
+        output_.setAggregatedSignals(aggregatedSignals);
+    }
+
+    void Module::setAggregationBuffer(Real* buffer, int nBanks)
+    {
+        output_.setAggregationBuffer(buffer, nBanks);
+    }
+
+    void Module::replayOutput(const SignalBank &output)
+    {
+        output_.copySamples(output);
+        output_.setTrig(output.getTrig());
+        output_.setUnchanged(false);
+        output_.setEarsIdentical(false);
+        output_.setChangedChannels(0, output_.getNChannels());
+        if (isOutputAggregated_)
+            output_.aggregate();
+    }
+
+    void Module::saveState(RealVec &state) const
+    {
+        state.push_back(output_.getTrig());
+        appendState(state, output_);
+        saveStateInternal(state);
+    }
+
+    bool Module::loadState(const RealVec &state, int &pos)
+    {
+        Real trig = 0;
+        if (!extractState(state, pos, trig) ||
+                !extractState(state, pos, output_) ||
+                !loadStateInternal(state, pos))
+        {
+            LOUDNESS_ERROR(name_ << ": State is incomplete.");
+            return 0;
+        }
+        output_.setTrig(trig != 0);
+        return 1;
+    }
+
+    void Module::saveStateInternal(RealVec &state) const
+    {
+    }
+
+    bool Module::loadStateInternal(const RealVec &state, int &pos)
+    {
+        return 1;
+    }
+
+    void Module::appendState(RealVec &state, const SignalBank &bank)
+    {
+        int nSamples = bank.getNTotalSamples();
+        if (nSamples > 0)
+        {
+            const Real* signals = bank.getSignalReadPointer(0, 0, 0, 0);
+            state.insert(state.end(), signals, signals + nSamples);
+        }
+    }
+
+    bool Module::extractState(const RealVec &state, int &pos,
+            SignalBank &bank)
+    {
+        int nSamples = bank.getNTotalSamples();
+        if (pos < 0 || pos + nSamples > (int)state.size())
+            return 0;
+        if (nSamples > 0)
+        {
+            std::copy(state.begin() + pos, state.begin() + pos + nSamples,
+                    bank.getSignalWritePointer(0, 0, 0, 0));
+        }
+        pos += nSamples;
+        return 1;
+    }
+
+    bool Module::extractState(const RealVec &state, int &pos, Real &value)
+    {
+        if (pos < 0 || pos >= (int)state.size())
+            return 0;
+        value = state[pos++];
+        return 1;
+    }
+
+    bool Module::isEquivalentTo(const Module& other) const
+    {
+        return false;
+    }
+
+    void Module::hashConfiguration(unsigned long long& hash) const {}
+}
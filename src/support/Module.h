@@ -21,9 +21,12 @@
 #define MODULE_H
 
 #include "SignalBank.h"
+#include <functional>
 
 namespace loudness{
 
+    class ThreadPool;
+
     /**
      * @class Module
      * 
@@ -60,7 +63,35 @@ namespace loudness{
      * processInternal() is only called if the SignalBank trigger is 1 (which is
      * the default), otherwise the output bank will not be updated.
      *
-     * @sa SignalBank
+     * By default, target modules are processed one after the other in the
+     * order they were added. If setThreadPool() and
+     * setTargetModulesProcessedInParallel() are used, the target modules are
+     * instead processed concurrently on the pool. This is only safe if the
+     * targets (and their own targets) share no modules, which is ensured by
+     * Model when it enables parallel branches.
+     *
+     * Modules whose processing is independent for each (source, ear) slice
+     * of the input can process the slices with processSlices(). If
+     * setSlicesProcessedInParallel() is used, the slices are dispatched to the
+     * thread pool in batches, otherwise they are processed in order on the
+     * calling thread. Such modules must keep any working memory per slice
+     * (see getNSlices()).
+     *
+     * A SignalBank can be flagged as having identical ears (see
+     * SignalBank::areEarsIdentical()), e.g. for dual-mono input. Slice based
+     * modules then process the first ear of each source only and copy the
+     * result to the other ears; modules with their own ear loops can do the
+     * same using getNEarsToProcess() and mirrorEars(). Use
+     * setEarComparisonUsed() on the first module receiving frames to set
+     * the flag by comparing the ears of its input.
+     *
+     * For a single stream, modules whose output channels can be computed
+     * independently (e.g. filter banks) can split the channel range using
+     * processChannels(). If setChannelsProcessedInParallel() is used, the
+     * ranges are processed concurrently, otherwise the whole range is
+     * processed on the calling thread.
+     *
+     * @sa SignalBank, ThreadPool
      */
     class Module
     {
@@ -68,6 +99,16 @@ namespace loudness{
         Module(const string& name = "Module");
         virtual ~Module();
 
+        /**
+         * @brief Returns a copy of this module, including its initialisation
+         * and current state, or nullptr if the module cannot be copied. The
+         * caller owns the returned module.
+         *
+         * The copy has the same target modules as this one, so it is up to
+         * the caller (normally Model::clone()) to redirect them.
+         */
+        virtual Module* clone() const;
+
         /**
          * @brief Initialises a module with no input.
          *
@@ -134,6 +175,55 @@ namespace loudness{
          */
         void removeLastTargetModule();
 
+        /**
+         * @brief Sets the ThreadPool used by this module. The pool is not owned
+         * and must outlive the module. Pass nullptr to process sequentially.
+         */
+        void setThreadPool(ThreadPool* threadPool);
+
+        /**
+         * @brief Sets whether the target modules are processed in parallel
+         * using the thread pool. The targets must not share any modules
+         * downstream.
+         */
+        void setTargetModulesProcessedInParallel(
+                bool areTargetModulesProcessedInParallel);
+
+        /**
+         * @brief Sets whether (source, ear) slices are processed in parallel
+         * using the thread pool. Only modules which use processSlices() are
+         * affected. Call this before initialize().
+         */
+        void setSlicesProcessedInParallel(bool areSlicesProcessedInParallel);
+
+        /** Returns true if slices are processed in parallel, false otherwise. */
+        bool areSlicesProcessedInParallel() const;
+
+        /**
+         * @brief Sets whether the ears of each input are compared with the
+         * first ear so that identical ears are processed once.
+         *
+         * Ears are identical if every sample differs from the corresponding
+         * sample of the first ear by no more than earTolerance times the peak
+         * magnitude of the first ear, so the default of zero requires
+         * bitwise (numerical) equality.
+         */
+        void setEarComparisonUsed(bool isEarComparisonUsed,
+                Real earTolerance = 0.0);
+
+        /**
+         * @brief Sets whether the channel ranges passed to processChannels()
+         * are processed in parallel using the thread pool. Only modules which
+         * use processChannels() are affected. Call this before initialize().
+         */
+        void setChannelsProcessedInParallel(bool areChannelsProcessedInParallel);
+
+        /** Returns true if channels are processed in parallel, false otherwise. */
+        bool areChannelsProcessedInParallel() const;
+
+        /** Returns the target modules in the order they were added. */
+        const vector<Module*>& getTargetModules() const;
+
         /** Sets whether the output SignalBank is aggregated or not. */
         void setOutputAggregated(bool isOutputAggregated);
 
@@ -162,6 +252,76 @@ namespace loudness{
          */
         const string& getName() const;
 
+        /**
+         * @brief Returns true if the output depends only on the current input,
+         * i.e. no state is carried from one process() call to the next.
+         *
+         * Such modules can process different frames of a signal concurrently
+         * on separate instances (see Model::setFrameParallelUsed()). The
+         * default is false.
+         */
+        virtual bool isStateless() const;
+
+        /**
+         * @brief Returns true if other is of the same type and configuration
+         * as this module, so that both produce the same output from the same
+         * input.
+         *
+         * Equivalent modules processing the same input can be shared, e.g.
+         * the spectral front end of several models (see ModelEnsemble). The
+         * default is false.
+         */
+        virtual bool isEquivalentTo(const Module& other) const;
+
+        /**
+         * @brief Updates hash with the parameters of the module which do not
+         * show in its output SignalBank, e.g. filter coefficients or the
+         * window type.
+         *
+         * Used to identify models with the same configuration (see
+         * Model::getUpstreamHash()). The default adds nothing, so modules
+         * with such parameters must override it.
+         */
+        virtual void hashConfiguration(unsigned long long& hash) const;
+
+        /**
+         * @brief Sets the output SignalBank (signals and trigger) to a result
+         * computed elsewhere, e.g. by another instance of this module, and
+         * aggregates it if required. processInternal() is not called and
+         * target modules are not processed.
+         *
+         * @param output Must have the same shape as the output SignalBank.
+         */
+        void replayOutput(const SignalBank &output);
+
+        /** Replaces the aggregated signals of the output SignalBank. */
+        void setAggregatedOutput(const RealVec &aggregatedSignals);
+
+        /** Aggregates the output SignalBank into a caller-owned buffer (see
+         * SignalBank::setAggregationBuffer()). */
+        void setAggregationBuffer(Real* buffer, int nBanks);
+
+        /**
+         * @brief Appends the dynamic state of the module to state.
+         *
+         * The state consists of the output trigger and signals followed by
+         * any internal buffers written by saveStateInternal(). Aggregated
+         * output is not included.
+         */
+        void saveState(RealVec &state) const;
+
+        /**
+         * @brief Restores the dynamic state written by saveState() on a
+         * module initialised with the same configuration.
+         *
+         * Reading starts at state[pos] and pos is advanced past the state of
+         * this module.
+         *
+         * @return true if the state was restored, false if state is too
+         * short.
+         */
+        bool loadState(const RealVec &state, int &pos);
+
     protected:
         //Pure virtual functions
         virtual bool initializeInternal(const SignalBank &input) = 0;
@@ -170,9 +330,81 @@ namespace loudness{
         virtual void processInternal() = 0;
         virtual void resetInternal() = 0;
 
+        /** Passes output_ to each target module for processing. */
+        virtual void processTargetModules();
+
+        /**
+         * @brief Calls processSlice(src, ear, bufferIdx) for every source and
+         * ear. bufferIdx indexes any per slice working memory and is less than
+         * getNSlices(nSources, nEars).
+         *
+         * When processed in parallel, slices are grouped so that each task
+         * covers at least minChannelsPerTask_ output channels, which avoids
+         * dispatching many tiny tasks at high frame rates.
+         */
+        void processSlices(int nSources, int nEars,
+                const std::function<void(int, int, int)>& processSlice);
+
+        /**
+         * @brief Splits [0, nChannels) into contiguous ranges and calls
+         * processRange(begin, end) for each.
+         *
+         * At most one range per thread is used and each range has at least
+         * minChannelsPerTask channels, so the cost of a range should
+         * outweigh the synchronisation (a few microseconds).
+         */
+        void processChannels(int nChannels, int minChannelsPerTask,
+                const std::function<void(int, int)>& processRange);
+
+        /** Returns 1 if the ears of the input being processed are identical,
+         * otherwise the number of input ears. */
+        int getNEarsToProcess(const SignalBank &input) const;
+
+        /** If the ears of the input being processed are identical, copies the
+         * first ear of each source of the output to the other ears and flags
+         * the output accordingly. */
+        void mirrorEars();
+
+        /** Returns the number of slices requiring independent working memory:
+         * nSources * nEars if slices are processed in parallel, 1
+         * otherwise. */
+        int getNSlices(int nSources, int nEars) const;
+
+        /**
+         * @brief Appends any state not held in the output SignalBank (delay
+         * lines, buffers, indices) to state. The default does nothing.
+         */
+        virtual void saveStateInternal(RealVec &state) const;
+
+        /**
+         * @brief Reads back the state written by saveStateInternal(),
+         * advancing pos. The default does nothing.
+         *
+         * @return false if state is too short.
+         */
+        virtual bool loadStateInternal(const RealVec &state, int &pos);
+
+        /** Appends all signals of bank to state. */
+        static void appendState(RealVec &state, const SignalBank &bank);
+
+        /** Reads all signals of bank from state[pos], advancing pos.
+         * Returns false if state is too short. */
+        static bool extractState(const RealVec &state, int &pos,
+                SignalBank &bank);
+
+        /** Reads a single value from state[pos], advancing pos. Returns
+         * false if state is too short. */
+        static bool extractState(const RealVec &state, int &pos, Real &value);
+
         //members
         string name_;
         bool initialized_, isOutputAggregated_;
+        bool areTargetModulesProcessedInParallel_, areSlicesProcessedInParallel_;
+        bool areChannelsProcessedInParallel_;
+        bool isEarComparisonUsed_, areInputEarsIdentical_;
+        Real earTolerance_;
+        int minChannelsPerTask_;
+        ThreadPool* threadPool_;
         vector<Module*> targetModules_;
         SignalBank output_;
     };
@@ -18,6 +18,7 @@
  */
 
 #include "SignalBank.h"
+#include "TableRegistry.h"
 
 namespace loudness{
 
@@ -27,11 +28,20 @@ namespace loudness{
         nChannels_(0),
         nSamples_(0),
         trig_(false),
+        isUnchanged_(false),
+        areEarsIdentical_(false),
         initialized_(false),
+        areCentreFreqsRegistered_(false),
+        changedChannelsBegin_(0),
+        changedChannelsEnd_(0),
         fs_(0),
         frameRate_(0),
         channelSpacingInCams_(0),
-        reserveSamples_(0)
+        reserveSamples_(0),
+        aggregationBuffer_(nullptr),
+        nAggregationBufferBanks_(0),
+        nBufferedBanks_(0),
+        centreFreqs_(std::make_shared<RealVec>())
     {}
 
     SignalBank::~SignalBank() {}
@@ -55,9 +65,14 @@ namespace loudness{
             fs_ = fs;
             frameRate_ = fs_;
             trig_ = 1;
+            isUnchanged_ = false;
+            areEarsIdentical_ = false;
+            changedChannelsBegin_ = 0;
+            changedChannelsEnd_ = nChannels_;
             initialized_ = true;
 
-            centreFreqs_.assign(nChannels_, 0.0);
+            centreFreqs_ = std::make_shared<RealVec>(nChannels_, 0.0);
+            areCentreFreqsRegistered_ = false;
             signals_.assign(nTotalSamples_, 0.0);
             aggregatedSignals_.clear();
             reserveSamples_ = nTotalSamples_ * 1000;
@@ -80,8 +95,13 @@ namespace loudness{
             fs_ = input.getFs();
             frameRate_ = input.getFrameRate();
             trig_ = input.getTrig();
+            isUnchanged_ = false;
+            areEarsIdentical_ = false;
+            changedChannelsBegin_ = 0;
+            changedChannelsEnd_ = nChannels_;
             initialized_ = true;
-            centreFreqs_ = input.getCentreFreqs();
+            centreFreqs_ = input.centreFreqs_;
+            areCentreFreqsRegistered_ = input.areCentreFreqsRegistered_;
             channelSpacingInCams_ = input.getChannelSpacingInCams();
             signals_.assign(input.getNTotalSamples(), 0.0);
             aggregatedSignals_.clear();
@@ -99,6 +119,10 @@ namespace loudness{
         signals_.assign(nTotalSamples_, 0.0);
         aggregatedSignals_.clear();
         trig_ = true;
+        isUnchanged_ = false;
+        areEarsIdentical_ = false;
+        changedChannelsBegin_ = 0;
+        changedChannelsEnd_ = nChannels_;
     }
 
     bool SignalBank::hasSameShape(const SignalBank& input) const
@@ -156,6 +180,23 @@ namespace loudness{
         aggregatedSignals_.clear();
     }
 
+    void SignalBank::setAggregatedSignals(const RealVec& aggregatedSignals)
+    {
+        aggregatedSignals_ = aggregatedSignals;
+    }
+
+    void SignalBank::setAggregationBuffer(Real* buffer, int nBanks)
+    {
+        aggregationBuffer_ = buffer;
+        nAggregationBufferBanks_ = buffer ? nBanks : 0;
+        nBufferedBanks_ = 0;
+    }
+
+    int SignalBank::getNBufferedBanks() const
+    {
+        return nBufferedBanks_;
+    }
+
     void SignalBank::setFs(int fs)
     {
         fs_ = fs;
@@ -178,7 +219,29 @@ namespace loudness{
 
     void SignalBank::setCentreFreqs(const RealVec &centreFreqs)
     {
-        centreFreqs_ = centreFreqs;
+        centreFreqs_ = std::make_shared<RealVec>(centreFreqs);
+        areCentreFreqsRegistered_ = false;
+    }
+
+    void SignalBank::shareCentreFreqs()
+    {
+        if (centreFreqs_ && !areCentreFreqsRegistered_)
+        {
+            //never modified in place from now on
+            centreFreqs_ = std::const_pointer_cast<RealVec>
+                (TableRegistry::share(*centreFreqs_));
+            areCentreFreqsRegistered_ = true;
+        }
+    }
+
+    RealVec& SignalBank::getCentreFreqsForWriting()
+    {
+        if (areCentreFreqsRegistered_ || (centreFreqs_.use_count() > 1))
+        {
+            centreFreqs_ = std::make_shared<RealVec>(*centreFreqs_);
+            areCentreFreqsRegistered_ = false;
+        }
+        return *centreFreqs_;
     }
 
     void SignalBank::copySamples(
@@ -260,6 +323,16 @@ namespace loudness{
 
     void SignalBank::aggregate()
     {  
+        if (aggregationBuffer_)
+        {
+            if (nBufferedBanks_ < nAggregationBufferBanks_)
+            {
+                std::copy(signals_.begin(), signals_.end(), aggregationBuffer_ +
+                        (long long)nBufferedBanks_ * nTotalSamples_);
+                ++nBufferedBanks_;
+            }
+            return;
+        }
         aggregatedSignals_.reserve(reserveSamples_);
         aggregatedSignals_.insert (aggregatedSignals_.end(), signals_.begin(), signals_.end());
     }
@@ -291,19 +364,19 @@ namespace loudness{
    
     const RealVec& SignalBank::getCentreFreqs() const
     {
-        return centreFreqs_;
+        return *centreFreqs_;
     }
 
     const Real* SignalBank::getCentreFreqsReadPointer(int channel) const
     {
         LOUDNESS_ASSERT(isPositiveAndLessThanUpper(channel, nChannels_));
-        return &centreFreqs_[channel];
+        return &(*centreFreqs_)[channel];
     }
 
     Real* SignalBank::getCentreFreqsWritePointer(int channel)
     {
         LOUDNESS_ASSERT(isPositiveAndLessThanUpper(channel, nChannels_));
-        return &centreFreqs_[channel];
+        return &getCentreFreqsForWriting()[channel];
     }
 
     int SignalBank::getFs() const
@@ -42,6 +42,13 @@ namespace loudness{
      * data. A trigger must be true (default) for a module to process the
      * SignalBank, otherwise the output will not updated. This is useful for
      * modules that process inputs at a rate lower than the host rate.
+     *
+     * A triggered SignalBank can also be flagged as unchanged, meaning its
+     * signals are the same as at the previous trigger. Stateless modules
+     * then keep their previous output rather than processing the input (see
+     * FrameGate). Similarly, the changed channels (all by default) tell
+     * modules which channels may differ from the previous trigger, so that
+     * channel-wise modules need only update those (see PowerSpectrum).
      * 
      * @author Dominic Ward
      */
@@ -93,6 +100,19 @@ namespace loudness{
          * */
         void clearAggregatedSignals();
 
+        /** Replaces the aggregated signals, e.g. with results stitched
+         * together from several SignalBanks. */
+        void setAggregatedSignals(const RealVec& aggregatedSignals);
+
+        /** Makes aggregate() write into a caller-owned buffer holding
+         * nBanks SignalBanks instead of the aggregated signals vector.
+         * Further SignalBanks are dropped. Pass a null buffer to revert. */
+        void setAggregationBuffer(Real* buffer, int nBanks);
+
+        /** Returns the number of SignalBanks written to the aggregation
+         * buffer. */
+        int getNBufferedBanks() const;
+
         /** Sets the sampling frequency.*/
         void setFs(int fs);
  
@@ -115,6 +135,11 @@ namespace loudness{
          */
         void setCentreFreqs(const RealVec &centreFreqs);
 
+        /** Replaces the centre frequencies with an identical table from the
+         * TableRegistry, so SignalBanks with the same centre frequencies
+         * share one copy. The table is copied again if modified. */
+        void shareCentreFreqs();
+
 
         /** Sets the centre frequency of a single channel.
          *
@@ -123,7 +148,7 @@ namespace loudness{
          */
         inline void setCentreFreq(int channel, Real freq)
         {
-            centreFreqs_[channel] = freq;
+            getCentreFreqsForWriting()[channel] = freq;
         }
 
        /** Sets the value of an individual sample in a specified ear and
@@ -188,6 +213,55 @@ namespace loudness{
             trig_ = trig;
         }
 
+        /** Flags the signals as unchanged since the previous trigger. */
+        inline void setUnchanged(bool isUnchanged)
+        {
+            isUnchanged_ = isUnchanged;
+        }
+
+        /** Returns true if the signals are unchanged since the previous
+         * trigger. Default is false. */
+        inline bool isUnchanged() const
+        {
+            return isUnchanged_;
+        }
+
+        /** Flags every ear of each source as holding the same signals as the
+         * first ear. */
+        inline void setEarsIdentical(bool areEarsIdentical)
+        {
+            areEarsIdentical_ = areEarsIdentical;
+        }
+
+        /** Returns true if every ear of each source holds the same signals as
+         * the first ear. Default is false. */
+        inline bool areEarsIdentical() const
+        {
+            return areEarsIdentical_;
+        }
+
+        /** Flags channels [begin, end) of every source and ear as the only
+         * ones that may have changed since the previous trigger. */
+        inline void setChangedChannels(int begin, int end)
+        {
+            changedChannelsBegin_ = begin;
+            changedChannelsEnd_ = end;
+        }
+
+        /** Returns the first channel which may have changed since the
+         * previous trigger. Default is 0. */
+        inline int getChangedChannelsBegin() const
+        {
+            return changedChannelsBegin_;
+        }
+
+        /** Returns one past the last channel which may have changed since
+         * the previous trigger. Default is the number of channels. */
+        inline int getChangedChannelsEnd() const
+        {
+            return changedChannelsEnd_;
+        }
+
         /** Returns the channel spacing in Cam units. */
         const Real getChannelSpacingInCams() const;
 
@@ -370,7 +444,7 @@ namespace loudness{
         inline Real getCentreFreq(int channel) const
         {
             LOUDNESS_ASSERT(isPositiveAndLessThanUpper(channel, nChannels_));
-            return centreFreqs_[channel];
+            return (*centreFreqs_)[channel];
         }
 
         /** Returns a reference to a vector of centre frequencies corresponding to each
@@ -406,14 +480,22 @@ namespace loudness{
 
     private:
 
+        /** Centre frequencies are shared (copy on write) with the
+         * SignalBank they were initialised from and with copies. */
+        RealVec& getCentreFreqsForWriting();
+
         int nSources_, nEars_, nChannels_, nSamples_;
         int nTotalSamples_, nTotalSamplesPerSource_, nTotalSamplesPerEar_;
-        bool trig_, initialized_;
+        bool trig_, isUnchanged_, areEarsIdentical_, initialized_;
+        bool areCentreFreqsRegistered_;
+        int changedChannelsBegin_, changedChannelsEnd_;
         int fs_;
         Real frameRate_, channelSpacingInCams_;
         long long reserveSamples_;
+        Real* aggregationBuffer_;
+        int nAggregationBufferBanks_, nBufferedBanks_;
         RealVec signals_, aggregatedSignals_;
-        RealVec centreFreqs_;
+        std::shared_ptr<RealVec> centreFreqs_;
     }; 
 }
 #endif 
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "StageCheckpoint.h"
+#include "../thirdParty/cnpy/cnpy.h"
+
+namespace loudness{
+
+    namespace {
+
+        //cnpy aborts on missing files, so these are checked first
+        bool loadRecording(const string& fileName, cnpy::npz_t& recording)
+        {
+            FILE* fp = fopen(fileName.c_str(), "rb");
+            if (!fp)
+                return 0;
+            fclose(fp);
+
+            try
+            {
+                recording = cnpy::npz_load(fileName);
+            }
+            catch (const std::exception&)
+            {
+                recording.destruct();
+                recording.clear();
+                return 0;
+            }
+            return 1;
+        }
+
+        //true if the recording was made with key for a stage shaped as stage
+        bool isRecordingValid(const cnpy::npz_t& recording,
+                unsigned long long key, const SignalBank& stage, int nHops)
+        {
+            auto keyArr = recording.find("key");
+            auto shapeArr = recording.find("shape");
+            auto trigsArr = recording.find("trigs");
+            auto framesArr = recording.find("frames");
+            if ((keyArr == recording.end()) || (shapeArr == recording.end())
+                    || (trigsArr == recording.end()) ||
+                    (framesArr == recording.end()))
+                return 0;
+
+            const int* shape = reinterpret_cast<const int*>
+                (shapeArr -> second.data);
+            if ((*reinterpret_cast<const unsigned long long*>
+                        (keyArr -> second.data) != key) ||
+                    (shape[0] != stage.getNSources()) ||
+                    (shape[1] != stage.getNEars()) ||
+                    (shape[2] != stage.getNChannels()) ||
+                    (shape[3] != stage.getNSamples()) ||
+                    ((int)trigsArr -> second.shape[0] != nHops))
+                return 0;
+
+            const unsigned char* trigs = reinterpret_cast<const unsigned char*>
+                (trigsArr -> second.data);
+            int nFrames = std::count(trigs, trigs + nHops, 1);
+            const cnpy::NpyArray& frames = framesArr -> second;
+            return (frames.shape.size() == 5) &&
+                ((int)frames.shape[0] == nFrames) &&
+                ((frames.word_size == sizeof(float)) ||
+                 (frames.word_size == sizeof(double)));
+        }
+
+        //replays the frames of a valid recording into model
+        void replayFrames(Model& model, const string& stageName,
+                cnpy::npz_t& recording, int nHops)
+        {
+            const unsigned char* trigs = reinterpret_cast<const unsigned char*>
+                (recording["trigs"].data);
+            const cnpy::NpyArray& frames = recording["frames"];
+            SignalBank stage;
+            stage.initialize(model.getOutput(stageName));
+            int nSamples = stage.getNTotalSamples();
+            Real* x = stage.getSignalWritePointer(0, 0, 0, 0);
+
+            model.reset();
+            int frame = 0;
+            for (int h = 0; h < nHops; ++h)
+            {
+                if (trigs[h])
+                {
+                    if (frames.word_size == sizeof(float))
+                    {
+                        const float* y = reinterpret_cast<const float*>
+                            (frames.data) + frame * nSamples;
+                        std::copy(y, y + nSamples, x);
+                    }
+                    else
+                    {
+                        const double* y = reinterpret_cast<const double*>
+                            (frames.data) + frame * nSamples;
+                        std::copy(y, y + nSamples, x);
+                    }
+                    ++frame;
+                }
+                stage.setTrig(trigs[h] != 0);
+                model.replayOutput(stageName, stage);
+            }
+            model.synchronize();
+        }
+    }
+
+    StageCheckpoint::StageCheckpoint(const string& stageName) :
+        stageName_(stageName),
+        isSinglePrecisionUsed_(false),
+        isReplayed_(false)
+    {
+        LOUDNESS_DEBUG("StageCheckpoint: Constructed");
+    }
+
+    StageCheckpoint::~StageCheckpoint() {};
+
+    unsigned long long StageCheckpoint::getKey(const Model& model,
+            const SignalBank& input, int nHops) const
+    {
+        unsigned long long key = model.getUpstreamHash(stageName_);
+        int shape[] = {input.getNSources(), input.getNEars(),
+            input.getNChannels(), input.getNSamples(), input.getFs(), nHops};
+        hashBytes(shape, sizeof(shape), key);
+        hashBytes(input.getSignalReadPointer(0, 0, 0, 0),
+                input.getNTotalSamples() * sizeof(Real), key);
+        return key;
+    }
+
+    bool StageCheckpoint::record(Model& model, const SignalBank& input,
+            int nHops, const string& fileName)
+    {
+        if (!model.isInitialized() || !model.hasOutput(stageName_) ||
+                (nHops < 1) || (input.getNSamples() < nHops) ||
+                (input.getNSamples() % nHops))
+        {
+            LOUDNESS_ERROR("StageCheckpoint: Cannot record " << stageName_);
+            return 0;
+        }
+
+        FILE* fp = fopen(fileName.c_str(), "wb");
+        if (!fp)
+        {
+            LOUDNESS_ERROR("StageCheckpoint: Cannot write " << fileName);
+            return 0;
+        }
+        fclose(fp);
+
+        int hopSize = input.getNSamples() / nHops;
+        SignalBank hop;
+        hop.initialize(input.getNSources(), input.getNEars(),
+                input.getNChannels(), hopSize, input.getFs());
+
+        const SignalBank& stage = model.getOutput(stageName_);
+        int nSamples = stage.getNTotalSamples();
+        vector<unsigned char> trigs;
+        RealVec frames;
+        vector<float> singleFrames;
+        model.reset();
+        for (int h = 0; h < nHops; ++h)
+        {
+            hop.copySamples(0, input, h * hopSize, hopSize);
+            model.process(hop);
+
+            //the stage output of this hop, not a later one
+            model.synchronize();
+            trigs.push_back(stage.getTrig());
+            if (stage.getTrig())
+            {
+                const Real* x = stage.getSignalReadPointer(0, 0, 0, 0);
+                if (isSinglePrecisionUsed_)
+                    singleFrames.insert(singleFrames.end(), x, x + nSamples);
+                else
+                    frames.insert(frames.end(), x, x + nSamples);
+            }
+        }
+
+        unsigned long long key = getKey(model, input, nHops);
+        int shape[] = {stage.getNSources(), stage.getNEars(),
+            stage.getNChannels(), stage.getNSamples()};
+        unsigned int nFrames = std::count(trigs.begin(), trigs.end(), 1);
+        unsigned int one = 1, four = 4, nTrigs = nHops;
+        unsigned int framesShape[] = {nFrames, (unsigned int)shape[0],
+            (unsigned int)shape[1], (unsigned int)shape[2],
+            (unsigned int)shape[3]};
+        try
+        {
+            cnpy::npz_save(fileName, "key", &key, &one, 1, "w");
+            cnpy::npz_save(fileName, "shape", shape, &four, 1, "a");
+            cnpy::npz_save(fileName, "trigs", trigs.data(), &nTrigs, 1, "a");
+            if (isSinglePrecisionUsed_)
+                cnpy::npz_save(fileName, "frames", singleFrames.data(),
+                        framesShape, 5, "a");
+            else
+                cnpy::npz_save(fileName, "frames", frames.data(),
+                        framesShape, 5, "a");
+        }
+        catch (const std::exception& e)
+        {
+            LOUDNESS_ERROR("StageCheckpoint: " << e.what());
+            return 0;
+        }
+
+        LOUDNESS_DEBUG("StageCheckpoint: Recorded " << nFrames
+                << " frames of " << stageName_ << " to " << fileName);
+        return 1;
+    }
+
+    bool StageCheckpoint::replay(Model& model, const SignalBank& input,
+            int nHops, const string& fileName)
+    {
+        if (!model.isInitialized() || !model.hasOutput(stageName_) ||
+                model.isFrameParallelActive())
+        {
+            LOUDNESS_ERROR("StageCheckpoint: Cannot replay " << stageName_);
+            return 0;
+        }
+
+        cnpy::npz_t recording;
+        if (!loadRecording(fileName, recording) ||
+                !isRecordingValid(recording, getKey(model, input, nHops),
+                    model.getOutput(stageName_), nHops))
+        {
+            LOUDNESS_ERROR("StageCheckpoint: " << fileName
+                    << " does not hold a matching recording.");
+            recording.destruct();
+            return 0;
+        }
+
+        replayFrames(model, stageName_, recording, nHops);
+        recording.destruct();
+
+        LOUDNESS_DEBUG("StageCheckpoint: Replayed " << stageName_
+                << " from " << fileName);
+        return 1;
+    }
+
+    bool StageCheckpoint::isRecorded(const Model& model,
+            const SignalBank& input, int nHops, const string& fileName) const
+    {
+        if (!model.isInitialized() || !model.hasOutput(stageName_))
+            return 0;
+
+        cnpy::npz_t recording;
+        if (!loadRecording(fileName, recording))
+            return 0;
+        bool isValid = isRecordingValid(recording,
+                getKey(model, input, nHops), model.getOutput(stageName_),
+                nHops);
+        recording.destruct();
+        return isValid;
+    }
+
+    bool StageCheckpoint::process(Model& model, const SignalBank& input,
+            int nHops, const string& fileName)
+    {
+        isReplayed_ = false;
+        if (!model.isInitialized() || !model.hasOutput(stageName_))
+        {
+            LOUDNESS_ERROR("StageCheckpoint: Cannot process " << stageName_);
+            return 0;
+        }
+
+        //the recording is loaded once, whether it matches or not
+        cnpy::npz_t recording;
+        if (!model.isFrameParallelActive() &&
+                loadRecording(fileName, recording) &&
+                isRecordingValid(recording, getKey(model, input, nHops),
+                    model.getOutput(stageName_), nHops))
+        {
+            replayFrames(model, stageName_, recording, nHops);
+            isReplayed_ = true;
+        }
+        recording.destruct();
+
+        if (isReplayed_)
+            return 1;
+        return record(model, input, nHops, fileName);
+    }
+
+    bool StageCheckpoint::isReplayed() const
+    {
+        return isReplayed_;
+    }
+
+    void StageCheckpoint::setSinglePrecisionUsed(bool isSinglePrecisionUsed)
+    {
+        isSinglePrecisionUsed_ = isSinglePrecisionUsed;
+    }
+
+    const string& StageCheckpoint::getStageName() const
+    {
+        return stageName_;
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef STAGECHECKPOINT_H
+#define STAGECHECKPOINT_H
+
+#include "Model.h"
+
+namespace loudness{
+
+    /**
+     * @class StageCheckpoint
+     *
+     * @brief Records the output of one stage of a model to disk and replays
+     * it through the modules downstream of that stage.
+     *
+     * Parameter sweeps often run the same audio through models which differ
+     * only after some stage, e.g. in the specific loudness, binaural
+     * inhibition or temporal integration. record() processes the audio once
+     * and stores the output of the named stage (any model output, such as
+     * "WeightedSpectrum" or "Excitation") for every hop. replay() then
+     * drives the downstream modules of another model with the stored
+     * frames, skipping everything upstream (see Model::replayOutput()). The
+     * outputs of a replayed model are identical to those of processing the
+     * audio.
+     *
+     * A recording is a numpy .npz file holding the key, the stage shape,
+     * the trigger of each hop and the frames of triggered hops only. Frames
+     * are stored in double precision, or in single precision to halve the
+     * size (see setSinglePrecisionUsed()), in which case replayed outputs
+     * differ by rounding.
+     *
+     * The key combines Model::getUpstreamHash() of the stage with a hash of
+     * the input samples, so a recording is only replayed into a model with
+     * the same upstream structure and for the same input. The structure
+     * covers module names, output shapes, rates and centre frequencies, and
+     * the parameters hashed by Module::hashConfiguration(), e.g. the
+     * high-pass filter, window type and outer and middle ear weights of the
+     * spectral front end, the interpolation of the roex banks and the
+     * time-constants of temporal integration. Only modules without such
+     * parameters, e.g. BinauralInhibitionMG2007, contribute their structure
+     * alone. process() replays a matching recording if there is one and
+     * records otherwise.
+     *
+     * The model must be initialised with a SignalBank of one hop. Outputs
+     * of interest are aggregated as usual (see
+     * Model::setOutputsToAggregate()). Recording synchronises the model
+     * after every hop; replaying requires a model without frame parallel
+     * processing.
+     */
+    class StageCheckpoint
+    {
+    public:
+        /**
+         * @brief Constructs a checkpoint of the model output stageName.
+         */
+        StageCheckpoint(const string& stageName = "WeightedSpectrum");
+
+        ~StageCheckpoint();
+
+        /** Returns the key identifying a recording of nHops hops of input
+         * with model. */
+        unsigned long long getKey(const Model& model, const SignalBank& input,
+                int nHops) const;
+
+        /**
+         * @brief Processes nHops consecutive hops of input with model, after
+         * resetting it, and writes the stage output of each hop to fileName.
+         * The number of samples in input must be a multiple of nHops.
+         *
+         * @return true if recorded, false otherwise.
+         */
+        bool record(Model& model, const SignalBank& input, int nHops,
+                const string& fileName);
+
+        /**
+         * @brief Resets model and replays the recording in fileName through
+         * the modules downstream of the stage.
+         *
+         * @return true if the recording matches the key of model, input and
+         * nHops and was replayed, false otherwise.
+         */
+        bool replay(Model& model, const SignalBank& input, int nHops,
+                const string& fileName);
+
+        /** Returns true if fileName holds a recording matching the key of
+         * model, input and nHops. */
+        bool isRecorded(const Model& model, const SignalBank& input,
+                int nHops, const string& fileName) const;
+
+        /** Replays fileName if it holds a matching recording, otherwise
+         * records it. Returns true if the model was processed either way. */
+        bool process(Model& model, const SignalBank& input, int nHops,
+                const string& fileName);
+
+        /** Returns true if the last call to process() replayed. */
+        bool isReplayed() const;
+
+        /** Stores frames in single precision (default false). */
+        void setSinglePrecisionUsed(bool isSinglePrecisionUsed);
+
+        const string& getStageName() const;
+
+    private:
+        string stageName_;
+        bool isSinglePrecisionUsed_, isReplayed_;
+    };
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "StationaryBatchProcessor.h"
+#include "ThreadPool.h"
+#include <atomic>
+
+namespace loudness{
+
+    StationaryBatchProcessor::StationaryBatchProcessor() :
+        nThreads_(0)
+    {
+        LOUDNESS_DEBUG("StationaryBatchProcessor: Constructed");
+    }
+
+    StationaryBatchProcessor::~StationaryBatchProcessor() {};
+
+    int StationaryBatchProcessor::addSpectra(Real* intensities, int nSpectra,
+            int nEars, int nComponents, const RealVec& frequencies)
+    {
+        if ((nSpectra < 1) || (nEars < 1) ||
+                (nComponents != (int)frequencies.size()))
+        {
+            LOUDNESS_ERROR("StationaryBatchProcessor: "
+                    << "Frequencies do not match the spectra.");
+            return -1;
+        }
+
+        Group group;
+        group.intensities.assign(intensities,
+                intensities + nSpectra * nEars * nComponents);
+        group.frequencies = frequencies;
+        group.nSpectra = nSpectra;
+        group.nEars = nEars;
+        group.isProcessed = false;
+        groups_.push_back(group);
+        return (int)groups_.size() - 1;
+    }
+
+    void StationaryBatchProcessor::clear()
+    {
+        groups_.clear();
+    }
+
+    void StationaryBatchProcessor::setOutputs(
+            const vector<string>& outputNames)
+    {
+        outputNames_ = outputNames;
+    }
+
+    int StationaryBatchProcessor::process(const Model& prototype)
+    {
+        if (prototype.isDynamic())
+        {
+            LOUDNESS_ERROR("StationaryBatchProcessor: Model is dynamic.");
+            return 0;
+        }
+
+        //one model per distinct grid, configured here...
+        for (const auto &group : groups_)
+        {
+            unique_ptr<Model>& model =
+                gridModels_[Grid(group.nEars, group.frequencies)];
+            if (model)
+                continue;
+
+            model.reset(prototype.clone());
+            if (!model)
+            {
+                LOUDNESS_ERROR("StationaryBatchProcessor: "
+                        << "Model cannot be cloned.");
+                gridModels_.clear();
+                return 0;
+            }
+            model -> setParallelBranchesUsed(false);
+            model -> setParallelSlicesUsed(false);
+            model -> setParallelChannelsUsed(false);
+            model -> setPipelineUsed(false);
+            model -> setFrameParallelUsed(false);
+        }
+
+        //...and initialised in parallel
+        vector<std::pair<const Grid, unique_ptr<Model>>*> grids;
+        for (auto &gridModel : gridModels_)
+            grids.push_back(&gridModel);
+
+        ThreadPool threadPool(nThreads_);
+        threadPool.parallelFor((int)grids.size(), [&](int i)
+        {
+            const Grid& grid = grids[i] -> first;
+            SignalBank input;
+            input.initialize(1, grid.first, (int)grid.second.size(), 1, 1);
+            input.setCentreFreqs(grid.second);
+            if (!grids[i] -> second -> initialize(input))
+                grids[i] -> second.reset();
+        });
+
+        //outputs of each group, shaped like the model outputs
+        struct Task
+        {
+            int group, begin, end;
+        };
+        vector<Task> tasks;
+        int nTasksPerGroup = 4 * threadPool.getNThreads();
+        for (int g = 0; g < (int)groups_.size(); ++g)
+        {
+            Group& group = groups_[g];
+            group.outputs.clear();
+            group.results.clear();
+            const unique_ptr<Model>& model =
+                gridModels_[Grid(group.nEars, group.frequencies)];
+            group.isProcessed = (bool)model;
+            if (!model)
+            {
+                LOUDNESS_WARNING("StationaryBatchProcessor: Group " << g
+                        << " not processed.");
+                continue;
+            }
+
+            for (const auto &outputName : outputNames_)
+            {
+                if (!model -> hasOutput(outputName))
+                {
+                    LOUDNESS_WARNING("StationaryBatchProcessor: "
+                            << outputName << " is not a model output.");
+                    continue;
+                }
+                group.outputs[outputName].initialize(
+                        model -> getOutput(outputName));
+                group.results[outputName].assign(group.nSpectra *
+                        model -> getOutput(outputName).getNTotalSamples(),
+                        0.0);
+            }
+
+            int spectraPerTask = max(group.nSpectra / nTasksPerGroup, 1);
+            for (int s = 0; s < group.nSpectra; s += spectraPerTask)
+                tasks.push_back({g, s, min(s + spectraPerTask,
+                            group.nSpectra)});
+        }
+
+        std::atomic<int> nProcessed(0);
+        threadPool.parallelFor((int)tasks.size(), [&](int i)
+        {
+            const Task& task = tasks[i];
+            if (processSpectra(groups_[task.group], task.begin, task.end))
+                nProcessed += task.end - task.begin;
+            else
+            {
+                std::lock_guard<std::mutex> lock(modelMutex_);
+                groups_[task.group].isProcessed = false;
+            }
+        });
+
+        for (auto &group : groups_)
+        {
+            for (auto &result : group.results)
+            {
+                if (group.isProcessed)
+                    group.outputs[result.first].setAggregatedSignals(
+                            result.second);
+                else
+                    group.outputs[result.first].clearAggregatedSignals();
+            }
+            group.results.clear();
+        }
+
+        idleModels_.clear();
+        gridModels_.clear();
+
+        LOUDNESS_DEBUG("StationaryBatchProcessor: " << nProcessed
+                << " spectra processed.");
+
+        return nProcessed;
+    }
+
+    bool StationaryBatchProcessor::processSpectra(Group& group, int begin,
+            int end)
+    {
+        Grid grid(group.nEars, group.frequencies);
+        unique_ptr<Model> model = acquireModel(grid);
+        if (!model)
+            return 0;
+
+        int nComponents = (int)group.frequencies.size();
+        int spectrumSize = group.nEars * nComponents;
+        SignalBank input;
+        input.initialize(1, group.nEars, nComponents, 1, 1);
+        input.setCentreFreqs(group.frequencies);
+
+        //each task writes its own spectra of the results
+        vector<const SignalBank*> modelOutputs;
+        vector<Real*> results;
+        for (auto &result : group.results)
+        {
+            modelOutputs.push_back(&model -> getOutput(result.first));
+            results.push_back(result.second.data());
+        }
+
+        Real* spectrum = input.getSignalWritePointer(0, 0, 0, 0);
+        for (int s = begin; s < end; ++s)
+        {
+            const Real* intensities = &group.intensities[s * spectrumSize];
+            std::copy(intensities, intensities + spectrumSize, spectrum);
+            model -> process(input);
+
+            for (uint o = 0; o < modelOutputs.size(); ++o)
+            {
+                int nSamples = modelOutputs[o] -> getNTotalSamples();
+                const Real* x = modelOutputs[o] -> getSignalReadPointer
+                    (0, 0, 0, 0);
+                std::copy(x, x + nSamples, results[o] + s * nSamples);
+            }
+            model -> reset();
+        }
+
+        releaseModel(grid, std::move(model));
+
+        return 1;
+    }
+
+    unique_ptr<Model> StationaryBatchProcessor::acquireModel(const Grid& grid)
+    {
+        std::lock_guard<std::mutex> lock(modelMutex_);
+        auto& idle = idleModels_[grid];
+        if (!idle.empty())
+        {
+            unique_ptr<Model> model = std::move(idle.back());
+            idle.pop_back();
+            return model;
+        }
+
+        //at most one model per thread and grid is ever created
+        return unique_ptr<Model> (gridModels_[grid] -> clone());
+    }
+
+    void StationaryBatchProcessor::releaseModel(const Grid& grid,
+            unique_ptr<Model> model)
+    {
+        std::lock_guard<std::mutex> lock(modelMutex_);
+        idleModels_[grid].push_back(std::move(model));
+    }
+
+    void StationaryBatchProcessor::setNThreads(int nThreads)
+    {
+        nThreads_ = nThreads;
+    }
+
+    int StationaryBatchProcessor::getNGroups() const
+    {
+        return (int)groups_.size();
+    }
+
+    int StationaryBatchProcessor::getNSpectra(int group) const
+    {
+        return groups_[group].nSpectra;
+    }
+
+    bool StationaryBatchProcessor::isGroupProcessed(int group) const
+    {
+        return groups_[group].isProcessed;
+    }
+
+    const SignalBank& StationaryBatchProcessor::getOutput(int group,
+            const string& outputName) const
+    {
+        auto search = groups_[group].outputs.find(outputName);
+        if (search == groups_[group].outputs.end())
+            return emptyOutput_;
+        return search -> second;
+    }
+}
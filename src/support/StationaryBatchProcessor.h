@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef STATIONARYBATCHPROCESSOR_H
+#define STATIONARYBATCHPROCESSOR_H
+
+#include "Common.h"
+#include "Model.h"
+#include <mutex>
+
+namespace loudness{
+
+    /**
+     * @class StationaryBatchProcessor
+     *
+     * @brief Evaluates a stationary loudness model over many spectra in
+     * parallel.
+     *
+     * Spectra are added in groups with addSpectra(), each group sharing a
+     * frequency grid. A stationary model is initialised once per distinct
+     * grid (and number of ears) rather than once per spectrum; groups with
+     * equal grids share models. Further models for the same grid are
+     * copied from the initialised one with Model::clone(), one per thread.
+     * The model is reset after each spectrum, which makes the results
+     * identical to processing the spectra one at a time.
+     *
+     * The results of a group are returned by getOutput() as a SignalBank
+     * shaped like the model output whose aggregated signals hold one frame
+     * per spectrum, in the order the spectra were added.
+     *
+     * Parallelism is across spectra only: the parallel options of the
+     * prototype are turned off in the clones.
+     *
+     * @sa BatchProcessor
+     */
+    class StationaryBatchProcessor
+    {
+    public:
+
+        StationaryBatchProcessor();
+        ~StationaryBatchProcessor();
+
+        /**
+         * @brief Adds a group of spectra sharing a frequency grid.
+         *
+         * @param intensities Component intensities, nSpectra x nEars x
+         * nComponents in row-major order.
+         * @param frequencies The nComponents component frequencies in Hz.
+         *
+         * @return The index of the group, or -1 if the grid does not match
+         * the number of components.
+         */
+        int addSpectra(Real* intensities, int nSpectra, int nEars,
+                int nComponents, const RealVec& frequencies);
+
+        /** Removes all groups and results. */
+        void clear();
+
+        /** Sets the names of the model outputs to keep for each spectrum. */
+        void setOutputs(const vector<string>& outputNames);
+
+        /**
+         * @brief Processes all spectra with clones of prototype.
+         *
+         * The prototype must be stationary and is not initialised or
+         * modified. Returns the number of spectra processed successfully.
+         */
+        int process(const Model& prototype);
+
+        /** Sets the number of threads (default 0, meaning the number of
+         * hardware threads). */
+        void setNThreads(int nThreads);
+
+        /** Returns the number of groups. */
+        int getNGroups() const;
+
+        /** Returns the number of spectra in a group. */
+        int getNSpectra(int group) const;
+
+        /** Returns false if the model could not be initialised with the
+         * grid of a group. */
+        bool isGroupProcessed(int group) const;
+
+        /** Returns the results of an output for a group. Uninitialised if
+         * the output is not kept or the group was not processed. */
+        const SignalBank& getOutput(int group, const string& outputName) const;
+
+    private:
+
+        struct Group
+        {
+            RealVec intensities, frequencies;
+            int nSpectra, nEars;
+            bool isProcessed;
+            map<string, SignalBank> outputs;
+            map<string, RealVec> results;
+        };
+
+        typedef std::pair<int, RealVec> Grid;
+
+        bool processSpectra(Group& group, int begin, int end);
+        unique_ptr<Model> acquireModel(const Grid& grid);
+        void releaseModel(const Grid& grid, unique_ptr<Model> model);
+
+        int nThreads_;
+        vector<string> outputNames_;
+        vector<Group> groups_;
+        map<Grid, vector<unique_ptr<Model>>> idleModels_;
+        map<Grid, unique_ptr<Model>> gridModels_;
+        std::mutex modelMutex_;
+        SignalBank emptyOutput_;
+    };
+}
+#endif
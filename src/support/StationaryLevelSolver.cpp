@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "StationaryLevelSolver.h"
+#include "ThreadPool.h"
+#include <atomic>
+
+namespace loudness{
+
+    StationaryLevelSolver::StationaryLevelSolver(const string& outputName) :
+        outputName_(outputName),
+        minLevel_(-20.0),
+        maxLevel_(120.0),
+        levelStep_(10.0),
+        tolerance_(0.001),
+        maxIterations_(50),
+        nThreads_(0),
+        areComponentsSolvedAlone_(false)
+    {
+        LOUDNESS_DEBUG("StationaryLevelSolver: Constructed");
+    }
+
+    StationaryLevelSolver::~StationaryLevelSolver() {};
+
+    void StationaryLevelSolver::setFrequencies(const RealVec& frequencies)
+    {
+        frequencies_ = frequencies;
+    }
+
+    void StationaryLevelSolver::setLevels(const RealVec& levels)
+    {
+        levels_ = levels;
+    }
+
+    int StationaryLevelSolver::addTarget(int component, Real targetLoudness)
+    {
+        Target target;
+        target.component = component;
+        target.loudness = targetLoudness;
+        target.isConverged = false;
+        target.nEvaluations = 0;
+        targets_.push_back(target);
+        solvedLevels_.push_back(0.0);
+        return (int)targets_.size() - 1;
+    }
+
+    void StationaryLevelSolver::clearTargets()
+    {
+        targets_.clear();
+        solvedLevels_.clear();
+    }
+
+    void StationaryLevelSolver::setLevelRange(Real minLevel, Real maxLevel,
+            Real levelStep)
+    {
+        minLevel_ = minLevel;
+        maxLevel_ = maxLevel;
+        levelStep_ = levelStep;
+    }
+
+    void StationaryLevelSolver::setTolerance(Real toleranceInDecibels)
+    {
+        tolerance_ = toleranceInDecibels;
+    }
+
+    void StationaryLevelSolver::setMaxIterations(int maxIterations)
+    {
+        maxIterations_ = maxIterations;
+    }
+
+    void StationaryLevelSolver::setNThreads(int nThreads)
+    {
+        nThreads_ = nThreads;
+    }
+
+    void StationaryLevelSolver::setComponentsSolvedAlone(
+            bool areComponentsSolvedAlone)
+    {
+        areComponentsSolvedAlone_ = areComponentsSolvedAlone;
+    }
+
+    int StationaryLevelSolver::solve(const Model& prototype)
+    {
+        int nComponents = (int)frequencies_.size();
+        if (prototype.isDynamic() || (nComponents == 0) ||
+                (!levels_.empty() && ((int)levels_.size() != nComponents)) ||
+                (maxLevel_ <= minLevel_) || (levelStep_ <= 0))
+        {
+            LOUDNESS_ERROR("StationaryLevelSolver: Model must be stationary "
+                    << "and the grid and level range valid.");
+            return 0;
+        }
+
+        for (const auto &target : targets_)
+        {
+            if ((target.component < 0) || (target.component >= nComponents)
+                    || (target.loudness <= 0))
+            {
+                LOUDNESS_ERROR("StationaryLevelSolver: Invalid target.");
+                return 0;
+            }
+        }
+
+        //the model is initialised once with the grid...
+        SignalBank input;
+        input.initialize(1, 1, nComponents, 1, 1);
+        input.setCentreFreqs(frequencies_);
+        for (int chn = 0; chn < nComponents; ++chn)
+        {
+            Real level = levels_.empty() ? -100.0 : levels_[chn];
+            input.setSample(0, 0, chn, 0, pow(10.0, level / 10.0));
+        }
+
+        unique_ptr<Model> model(prototype.clone());
+        if (!model)
+        {
+            LOUDNESS_ERROR("StationaryLevelSolver: Model cannot be cloned.");
+            return 0;
+        }
+        model -> setParallelBranchesUsed(false);
+        model -> setParallelSlicesUsed(false);
+        model -> setParallelChannelsUsed(false);
+        if (!model -> initialize(input) || !model -> hasOutput(outputName_))
+        {
+            LOUDNESS_ERROR("StationaryLevelSolver: Model has no output "
+                    << outputName_);
+            return 0;
+        }
+
+        //...and copied for each task, which solve targets in turn, either
+        //on the grid or reinitialised with the target's component alone
+        ThreadPool threadPool(nThreads_);
+        int nTasks = min(threadPool.getNThreads(), (int)targets_.size());
+        vector<unique_ptr<Model>> models;
+        models.push_back(std::move(model));
+        for (int task = 1; task < nTasks; ++task)
+            models.push_back(unique_ptr<Model> (models[0] -> clone()));
+
+        std::atomic<int> nextTarget(0), nConverged(0);
+        threadPool.parallelFor(nTasks, [&](int task)
+        {
+            SignalBank taskInput;
+            if (areComponentsSolvedAlone_)
+            {
+                taskInput.initialize(1, 1, 1, 1, 1);
+            }
+            else
+            {
+                taskInput.initialize(input);
+                taskInput.copySamples(input);
+            }
+            for (int i = nextTarget++; i < (int)targets_.size();
+                    i = nextTarget++)
+            {
+                int component = targets_[i].component;
+                if (areComponentsSolvedAlone_)
+                {
+                    taskInput.setCentreFreq(0, frequencies_[component]);
+                    models[task] -> initialize(taskInput);
+                    component = 0;
+                }
+                solveTarget(*models[task], taskInput, component, targets_[i],
+                        solvedLevels_[i]);
+                if (targets_[i].isConverged)
+                    nConverged++;
+            }
+        });
+
+        LOUDNESS_DEBUG("StationaryLevelSolver: " << nConverged << " of "
+                << targets_.size() << " targets converged.");
+
+        return nConverged;
+    }
+
+    void StationaryLevelSolver::solveTarget(Model& model, SignalBank& input,
+            int component, Target& target, Real& level)
+    {
+        target.isConverged = false;
+        target.nEvaluations = 0;
+        Real baseIntensity = input.getSample(0, 0, component, 0);
+
+        //bracket the level with a binary search of the candidate levels
+        int lo = 0;
+        int hi = (int)ceil((maxLevel_ - minLevel_) / levelStep_);
+        Real a = minLevel_;
+        Real b = min(minLevel_ + hi * levelStep_, maxLevel_);
+        Real fa = computeLoudness(model, input, component, target, a)
+            - target.loudness;
+        Real fb = computeLoudness(model, input, component, target, b)
+            - target.loudness;
+
+        if ((fa >= 0) || (fb < 0))
+        {
+            LOUDNESS_WARNING("StationaryLevelSolver: Target loudness "
+                    << target.loudness << " outside of level range.");
+            level = (fa >= 0) ? a : b;
+            target.isConverged = (fa == 0) || (fb == 0);
+            input.setSample(0, 0, component, 0, baseIntensity);
+            return;
+        }
+
+        while (hi - lo > 1)
+        {
+            int mid = (lo + hi) / 2;
+            Real m = minLevel_ + mid * levelStep_;
+            Real fm = computeLoudness(model, input, component, target, m)
+                - target.loudness;
+            if (fm < 0)
+            {
+                lo = mid;
+                a = m;
+                fa = fm;
+            }
+            else
+            {
+                hi = mid;
+                b = m;
+                fb = fm;
+            }
+        }
+
+        //Brent's method: inverse quadratic interpolation, secant and
+        //bisection, keeping the root bracketed by b and c
+        Real c = a, fc = fa;
+        Real d = b - a, e = d;
+        for (int iter = 0; iter < maxIterations_; ++iter)
+        {
+            if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0))
+            {
+                c = a;
+                fc = fa;
+                d = e = b - a;
+            }
+            if (fabs(fc) < fabs(fb))
+            {
+                a = b;
+                b = c;
+                c = a;
+                fa = fb;
+                fb = fc;
+                fc = fa;
+            }
+
+            Real tol = 0.5 * tolerance_;
+            Real xm = 0.5 * (c - b);
+            if ((fabs(xm) <= tol) || (fb == 0))
+            {
+                target.isConverged = true;
+                break;
+            }
+
+            if ((fabs(e) >= tol) && (fabs(fa) > fabs(fb)))
+            {
+                Real p, q, s = fb / fa;
+                if (a == c)
+                {
+                    p = 2.0 * xm * s;
+                    q = 1.0 - s;
+                }
+                else
+                {
+                    Real r = fb / fc;
+                    q = fa / fc;
+                    p = s * (2.0 * xm * q * (q - r) - (b - a) * (r - 1.0));
+                    q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+                }
+                if (p > 0)
+                    q = -q;
+                p = fabs(p);
+
+                //accept the interpolation only if it stays well inside
+                if (2.0 * p < min(3.0 * xm * q - fabs(tol * q), fabs(e * q)))
+                {
+                    e = d;
+                    d = p / q;
+                }
+                else
+                {
+                    d = xm;
+                    e = d;
+                }
+            }
+            else
+            {
+                d = xm;
+                e = d;
+            }
+
+            a = b;
+            fa = fb;
+            if (fabs(d) > tol)
+                b += d;
+            else
+                b += (xm > 0) ? tol : -tol;
+            fb = computeLoudness(model, input, component, target, b)
+                - target.loudness;
+        }
+
+        if (!target.isConverged)
+        {
+            LOUDNESS_WARNING("StationaryLevelSolver: Not converged after "
+                    << maxIterations_ << " iterations.");
+        }
+
+        level = b;
+        input.setSample(0, 0, component, 0, baseIntensity);
+    }
+
+    Real StationaryLevelSolver::computeLoudness(Model& model,
+            SignalBank& input, int component, Target& target, Real level)
+    {
+        input.setSample(0, 0, component, 0, pow(10.0, level / 10.0));
+        model.process(input);
+        Real loudness = model.getOutput(outputName_).getSample(0, 0, 0, 0);
+        model.reset();
+        target.nEvaluations++;
+        return loudness;
+    }
+
+    int StationaryLevelSolver::getNTargets() const
+    {
+        return (int)targets_.size();
+    }
+
+    Real StationaryLevelSolver::getLevel(int target) const
+    {
+        return solvedLevels_[target];
+    }
+
+    const RealVec& StationaryLevelSolver::getLevels() const
+    {
+        return solvedLevels_;
+    }
+
+    bool StationaryLevelSolver::isConverged(int target) const
+    {
+        return targets_[target].isConverged;
+    }
+
+    int StationaryLevelSolver::getNEvaluations(int target) const
+    {
+        return targets_[target].nEvaluations;
+    }
+}
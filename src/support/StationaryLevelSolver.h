@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef STATIONARYLEVELSOLVER_H
+#define STATIONARYLEVELSOLVER_H
+
+#include "Common.h"
+#include "Model.h"
+
+namespace loudness{
+
+    /**
+     * @class StationaryLevelSolver
+     *
+     * @brief Finds the levels at which components of a spectrum reach target
+     * loudnesses with a stationary loudness model, e.g. for predicting equal
+     * loudness contours and absolute thresholds.
+     *
+     * The spectrum is a set of components on a fixed frequency grid (see
+     * setFrequencies()). Each target (see addTarget()) names a component and
+     * a loudness; all other components are held at the levels set with
+     * setLevels() (default -100 dB). solve() finds, for every target, the
+     * level of its component at which the first sample of the model output
+     * equals the target loudness.
+     *
+     * Loudness increases monotonically with level, so the root is first
+     * bracketed by a binary search of a grid of candidate levels (see
+     * setLevelRange()) and then refined with Brent's method until the
+     * bracket is narrower than the tolerance. Targets outside the loudness
+     * range of the grid are not converged and take the nearest limit.
+     *
+     * The model is initialised once with the grid and copied with
+     * Model::clone() for each thread; targets are solved in parallel. With
+     * setComponentsSolvedAlone(), each target is instead solved on a grid
+     * holding only its component, and the copy is initialised per target.
+     *
+     * @sa StationaryBatchProcessor
+     */
+    class StationaryLevelSolver
+    {
+    public:
+
+        /**
+         * @brief Constructs a solver.
+         *
+         * @param outputName The model output holding the loudness.
+         */
+        StationaryLevelSolver(const string& outputName = "Loudness");
+        ~StationaryLevelSolver();
+
+        /** Sets the component frequencies in Hz. */
+        void setFrequencies(const RealVec& frequencies);
+
+        /** Sets the levels in dB of the components not being solved. Must
+         * be empty (all at -100 dB) or match the frequencies in size. */
+        void setLevels(const RealVec& levels);
+
+        /** Adds a target and returns its index. */
+        int addTarget(int component, Real targetLoudness);
+
+        /** Removes all targets and results. */
+        void clearTargets();
+
+        /** Sets the candidate levels used for bracketing (default -20 to
+         * 120 dB in 10 dB steps). */
+        void setLevelRange(Real minLevel, Real maxLevel, Real levelStep);
+
+        /** Sets the bracket width in dB at which Brent's method stops
+         * (default 0.001 dB). */
+        void setTolerance(Real toleranceInDecibels);
+
+        /** Sets the maximum number of Brent iterations per target
+         * (default 50). */
+        void setMaxIterations(int maxIterations);
+
+        /** Sets the number of threads (default 0, meaning the number of
+         * hardware threads). */
+        void setNThreads(int nThreads);
+
+        /** If true, each target is solved with a spectrum holding its
+         * component only, and the levels of the other components are
+         * ignored (default false). */
+        void setComponentsSolvedAlone(bool areComponentsSolvedAlone);
+
+        /**
+         * @brief Solves all targets with clones of prototype.
+         *
+         * The prototype must be stationary and is not initialised or
+         * modified. Returns the number of targets converged.
+         */
+        int solve(const Model& prototype);
+
+        /** Returns the number of targets. */
+        int getNTargets() const;
+
+        /** Returns the solved level of a target in dB. */
+        Real getLevel(int target) const;
+
+        /** Returns the solved levels of all targets in dB. */
+        const RealVec& getLevels() const;
+
+        /** Returns true if the target was converged. */
+        bool isConverged(int target) const;
+
+        /** Returns the number of model evaluations used for a target. */
+        int getNEvaluations(int target) const;
+
+    private:
+
+        struct Target
+        {
+            int component;
+            Real loudness;
+            bool isConverged;
+            int nEvaluations;
+        };
+
+        void solveTarget(Model& model, SignalBank& input, int component,
+                Target& target, Real& level);
+        Real computeLoudness(Model& model, SignalBank& input, int component,
+                Target& target, Real level);
+
+        string outputName_;
+        RealVec frequencies_, levels_, solvedLevels_;
+        Real minLevel_, maxLevel_, levelStep_, tolerance_;
+        int maxIterations_, nThreads_;
+        bool areComponentsSolvedAlone_;
+        vector<Target> targets_;
+    };
+}
+#endif
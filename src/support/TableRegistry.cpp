@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "TableRegistry.h"
+#include <mutex>
+
+namespace loudness{
+
+    namespace {
+
+        //FNV-1a over the bit patterns of the values
+        void hashValues(const RealVec& values, size_t& hash)
+        {
+            const unsigned char* bytes =
+                reinterpret_cast<const unsigned char*>(values.data());
+            size_t nBytes = values.size() * sizeof(Real);
+            for (size_t i = 0; i < nBytes; ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            hash = (hash ^ values.size()) * 1099511628211ULL;
+        }
+
+        size_t hashTable(const RealVec& table)
+        {
+            size_t hash = 14695981039346656037ULL;
+            hashValues(table, hash);
+            return hash;
+        }
+
+        size_t hashTable(const RealVecVec& table)
+        {
+            size_t hash = 14695981039346656037ULL;
+            for (const auto &row : table)
+                hashValues(row, hash);
+            return hash;
+        }
+
+        template <typename Table>
+        using TableMap = std::multimap<size_t, std::weak_ptr<const Table>>;
+
+        std::mutex mutex;
+        TableMap<RealVec> vectors;
+        TableMap<RealVecVec> matrices;
+
+        //erases the entries of freed tables, returns the number left
+        template <typename Table>
+        int pruneTables(TableMap<Table>& tables)
+        {
+            int nTables = 0;
+            for (auto it = tables.begin(); it != tables.end();)
+            {
+                if (it -> second.expired())
+                {
+                    it = tables.erase(it);
+                }
+                else
+                {
+                    ++nTables;
+                    ++it;
+                }
+            }
+            return nTables;
+        }
+
+        template <typename Table>
+        std::shared_ptr<const Table> shareTable(const Table& table,
+                TableMap<Table>& tables)
+        {
+            size_t hash = hashTable(table);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto range = tables.equal_range(hash);
+            for (auto it = range.first; it != range.second;)
+            {
+                std::shared_ptr<const Table> shared = it -> second.lock();
+                if (!shared)
+                {
+                    it = tables.erase(it);
+                }
+                else if (*shared == table)
+                {
+                    return shared;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            //not make_shared, so a freed table does not wait for its entry
+            std::shared_ptr<const Table> shared(new Table(table));
+            pruneTables(tables);
+            tables.insert(std::make_pair(hash,
+                        std::weak_ptr<const Table>(shared)));
+            return shared;
+        }
+
+    }
+
+    std::shared_ptr<const RealVec> TableRegistry::share(const RealVec& table)
+    {
+        return shareTable(table, vectors);
+    }
+
+    std::shared_ptr<const RealVecVec> TableRegistry::share(
+            const RealVecVec& table)
+    {
+        return shareTable(table, matrices);
+    }
+
+    int TableRegistry::getNTables()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pruneTables(vectors) + pruneTables(matrices);
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef TABLEREGISTRY_H
+#define TABLEREGISTRY_H
+
+#include "Common.h"
+
+namespace loudness{
+
+    /**
+     * @class TableRegistry
+     *
+     * @brief A process-wide store of immutable tables shared between module
+     * instances.
+     *
+     * Modules which compute large constant tables during initialisation
+     * (filter weights, lookup tables, centre frequencies) pass them to
+     * share(), which returns a reference counted, read-only table. Tables
+     * are keyed by content, so all instances of a model with the same
+     * configuration hold one copy of each table, however many instances
+     * exist. The registry only keeps weak references: a table is freed when
+     * the last module using it is destroyed or re-initialised, and its entry
+     * is erased when the next table is added.
+     *
+     * share() is thread safe.
+     */
+    class TableRegistry
+    {
+    public:
+
+        /** Returns a shared table with the contents of table. */
+        static std::shared_ptr<const RealVec> share(const RealVec& table);
+
+        /** Returns a shared table with the contents of table. */
+        static std::shared_ptr<const RealVecVec> share(const RealVecVec& table);
+
+        /** Returns the number of tables currently shared. */
+        static int getNTables();
+    };
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#include "ThreadPool.h"
+
+namespace loudness{
+
+    ThreadPool::ThreadPool(int nThreads, Real spinTime) :
+        nThreads_(nThreads),
+        nParkedWorkers_(0),
+        spinTime_(spinTime),
+        stop_(false),
+        jobGeneration_(0)
+    {
+        if (nThreads_ < 1)
+            nThreads_ = std::max((int)std::thread::hardware_concurrency(), 1);
+
+        for (int i = 1; i < nThreads_; ++i)
+            workers_.push_back(std::thread(&ThreadPool::workerLoop, this));
+
+        LOUDNESS_DEBUG("ThreadPool: Constructed with "
+                << nThreads_ << " threads.");
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        workAvailable_.notify_all();
+        for (auto &worker : workers_)
+            worker.join();
+    }
+
+    void ThreadPool::parallelFor(int nTasks, const std::function<void(int)>& task)
+    {
+        if (nTasks < 1)
+            return;
+
+        //nothing to share
+        if ((nTasks == 1) || workers_.empty())
+        {
+            for (int i = 0; i < nTasks; ++i)
+                task(i);
+            return;
+        }
+
+        Job job;
+        job.task = &task;
+        job.nTasks = nTasks;
+        job.nextTask = 0;
+        job.nCompletedTasks = 0;
+
+        bool isAnyWorkerParked;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(&job);
+            jobGeneration_++;
+            isAnyWorkerParked = nParkedWorkers_ > 0;
+        }
+
+        //spinning workers pick the job up without a wake up call
+        if (isAnyWorkerParked)
+            workAvailable_.notify_all();
+
+        //the caller works on its own job too
+        while (runNextTask(job))
+        {}
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.remove(&job);
+        }
+
+        //wait for tasks still running on other threads
+        auto isComplete = [&job]{
+            return job.nCompletedTasks.load() == job.nTasks;};
+        if (!spinUntil(isComplete))
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCompleted_.wait(lock, isComplete);
+        }
+    }
+
+    bool ThreadPool::spinUntil(const std::function<bool()>& condition) const
+    {
+        if (condition())
+            return true;
+        if (spinTime_ <= 0)
+            return false;
+
+        auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration<Real>(spinTime_);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (condition())
+                return true;
+            std::this_thread::yield();
+        }
+        return condition();
+    }
+
+    bool ThreadPool::runNextTask(Job& job)
+    {
+        int i = job.nextTask.fetch_add(1);
+        if (i >= job.nTasks)
+            return false;
+        runTask(job, i);
+        return true;
+    }
+
+    void ThreadPool::runTask(Job& job, int i)
+    {
+        (*job.task)(i);
+
+        //job must not be touched after the final completion
+        int nTasks = job.nTasks;
+        if ((job.nCompletedTasks.fetch_add(1) + 1) == nTasks)
+        {
+            //lock so the waiting caller cannot miss the notification
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobCompleted_.notify_all();
+        }
+    }
+
+    bool ThreadPool::claimTask(Job*& job, int& i)
+    {
+        for (auto candidate : jobs_)
+        {
+            if (candidate -> nextTask.load() < candidate -> nTasks)
+            {
+                i = candidate -> nextTask.fetch_add(1);
+                if (i < candidate -> nTasks)
+                {
+                    job = candidate;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while (true)
+        {
+            Job* job = nullptr;
+            int i = 0;
+            unsigned int generation = 0;
+
+            /*
+             * Claiming under the lock keeps the job alive: its caller
+             * cannot return until the claimed task completes.
+             */
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stop_)
+                    return;
+                if (!claimTask(job, i))
+                    generation = jobGeneration_;
+            }
+
+            //spin for a while before parking, a new job is likely soon
+            if (!job)
+            {
+                if (spinUntil([this, generation]{
+                            return stop_ || (jobGeneration_ != generation);}))
+                    continue;
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                nParkedWorkers_++;
+                workAvailable_.wait(lock, [this, &job, &i]{
+                        return stop_ || claimTask(job, i);});
+                nParkedWorkers_--;
+                if (!job)
+                    return;
+            }
+
+            runTask(*job, i);
+        }
+    }
+
+    void ThreadPool::setSpinTime(Real spinTime)
+    {
+        spinTime_ = spinTime;
+    }
+
+    int ThreadPool::getNThreads() const
+    {
+        return nThreads_;
+    }
+}
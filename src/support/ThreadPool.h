@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2014 Dominic Ward <contactdominicward@gmail.com>
+ *
+ * This file is part of Loudness
+ *
+ * Loudness is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Loudness is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Loudness.  If not, see <http://www.gnu.org/licenses/>. 
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "Common.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace loudness{
+
+    /**
+     * @class ThreadPool
+     *
+     * @brief A fixed group of worker threads for running independent tasks.
+     *
+     * Work is submitted with parallelFor(), which runs task(i) for every i in
+     * [0, nTasks) and returns once all tasks are complete. The calling thread
+     * takes part in the work, so a pool constructed with nThreads = N uses
+     * N - 1 worker threads. Tasks are claimed one at a time from a shared
+     * counter, which balances the load when tasks differ in cost.
+     *
+     * parallelFor() may be called from within a task (e.g. a module
+     * processing its (source, ear) slices in parallel whilst running on a
+     * parallel branch of a model). Idle workers help with any unfinished job
+     * and a caller can always complete its own job, so nesting cannot
+     * deadlock.
+     *
+     * Idle threads (workers waiting for a job and callers waiting for other
+     * threads to finish their tasks) first spin, yielding the processor, for
+     * up to the spin time before parking on a condition variable. When jobs
+     * arrive more often than the spin time, as for a stream processed at a
+     * high frame rate, no thread has to be woken up, which keeps the cost of
+     * each parallelFor() in the order of microseconds. Set the spin time to 0
+     * to park immediately.
+     *
+     * The pool is not copyable and must outlive any object using it.
+     */
+    class ThreadPool
+    {
+    public:
+
+        /**
+         * @brief Constructs a ThreadPool.
+         *
+         * @param nThreads Total number of threads to use, including the
+         * caller. If less than 1, the number of hardware threads is used.
+         * @param spinTime Time in seconds an idle thread spins before parking.
+         */
+        ThreadPool(int nThreads = 0, Real spinTime = 0.0002);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Runs task(i) for i = 0, 1, ..., nTasks - 1 and blocks until
+         * all have returned.
+         *
+         * No ordering between tasks is guaranteed, so tasks must not write to
+         * shared data.
+         */
+        void parallelFor(int nTasks, const std::function<void(int)>& task);
+
+        /** Returns the total number of threads, including the caller. */
+        int getNThreads() const;
+
+        /** Sets the time in seconds an idle thread spins before parking. */
+        void setSpinTime(Real spinTime);
+
+    private:
+
+        struct Job
+        {
+            const std::function<void(int)>* task;
+            int nTasks;
+            std::atomic<int> nextTask, nCompletedTasks;
+        };
+
+        void workerLoop();
+        bool runNextTask(Job& job);
+        void runTask(Job& job, int i);
+        bool claimTask(Job*& job, int& i);
+        bool spinUntil(const std::function<bool()>& condition) const;
+
+        int nThreads_, nParkedWorkers_;
+        std::atomic<Real> spinTime_;
+        std::atomic<bool> stop_;
+        std::atomic<unsigned int> jobGeneration_;
+        vector<std::thread> workers_;
+        std::list<Job*> jobs_;
+        std::mutex mutex_;
+        std::condition_variable workAvailable_, jobCompleted_;
+    };
+}
+
+#endif
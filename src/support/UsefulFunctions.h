@@ -159,6 +159,17 @@ namespace loudness{
     {
         return power > minValue ? 10 * std::log10 (power) : clipValue;
     }
+
+    /** Updates an FNV-1a hash with the nBytes bytes starting at data. Start
+     * from 14695981039346656037. */
+    inline void hashBytes(const void* data, size_t nBytes,
+            unsigned long long& hash)
+    {
+        const unsigned char* bytes =
+            reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < nBytes; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
 }
 
 #endif 
@@ -46,7 +46,7 @@ namespace cnpy {
 
     template<typename T> std::vector<char>& operator+=(std::vector<char>& lhs, const T rhs) {
         //write in little endian
-        for(char byte = 0; byte < sizeof(T); byte++) {
+        for(size_t byte = 0; byte < sizeof(T); byte++) {
             char val = *((char*)&rhs+byte); 
             lhs.push_back(val);
         }
@@ -148,7 +148,7 @@ namespace cnpy {
         std::vector<char> npy_header = create_npy_header(data,shape,ndims);
 
         unsigned long nels = 1;
-        for (int m=0; m<ndims; m++ ) nels *= shape[m];
+        for (unsigned int m=0; m<ndims; m++ ) nels *= shape[m];
         int nbytes = nels*sizeof(T) + npy_header.size();
 
         //get the CRC of the data to be added
@@ -213,7 +213,7 @@ namespace cnpy {
         dict += tostring(sizeof(T));
         dict += "', 'fortran_order': False, 'shape': (";
         dict += tostring(shape[0]);
-        for(int i = 1;i < ndims;i++) {
+        for(unsigned int i = 1;i < ndims;i++) {
             dict += ", ";
             dict += tostring(shape[i]);
         }
@@ -2,7 +2,50 @@
 Expose only a subset of SignalBank's public members
 Extend the class with signal setters and getters for integration with Numpy
 arrays.
+
+Signal, aggregated signal and centre frequency getters return copies.
+
+getSignalView(), getSignalsView() and getCentreFreqsView() instead return
+read-only numpy views of the bank's storage, avoiding the copy when the data
+is consumed straight away (e.g. once per frame). A view holds a reference to
+the Python object of the bank, and banks returned by getOutput() hold a
+reference to their model, but this does not keep the storage alive: a view
+is invalid once the bank is reinitialised, its model is reinitialised or
+its centre frequencies are modified. Its contents change as the model
+processes. Copy a view to keep it.
+
+Setters copy from the numpy array straight into the bank. Contiguous arrays
+of doubles are not copied beforehand.
 */
+%{
+static PyObject* signalBankCopy(int nDims, npy_intp* dims, const Real* data)
+{
+    PyObject* array = PyArray_SimpleNew(nDims, dims, NPY_DOUBLE);
+    if (!array)
+        return NULL;
+    npy_intp size = PyArray_SIZE((PyArrayObject*)array);
+    std::copy(data, data + size, (Real*)PyArray_DATA((PyArrayObject*)array));
+    return array;
+}
+
+static PyObject* signalBankView(PyObject* owner, int nDims, npy_intp* dims,
+        const Real* data)
+{
+    PyObject* array = PyArray_SimpleNewFromData(nDims, dims, NPY_DOUBLE,
+            (void*)data);
+    if (!array)
+        return NULL;
+    PyArray_CLEARFLAGS((PyArrayObject*)array, NPY_ARRAY_WRITEABLE);
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject((PyArrayObject*)array, owner) < 0)
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+    return array;
+}
+%}
+
 namespace loudness{
 class SignalBank {
 
@@ -28,6 +71,7 @@ public:
     void getFrameRate() const;
     void setChannelSpacingInCams(Real channelSpacingInCams);
     void aggregate();
+    bool isInitialized() const;
     
     %extend {
 
@@ -42,7 +86,7 @@ public:
             const Real* ptr;
             ptr = $self -> getSignalReadPointer(source, ear, channel, 0);
             npy_intp dims[1] = {$self -> getNSamples()}; 
-            return PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (void*)ptr);
+            return signalBankCopy(1, dims, ptr);
         }
 
         PyObject* getSignals()
@@ -53,7 +97,33 @@ public:
                                 $self -> getNEars(),
                                 $self -> getNChannels(),
                                 $self -> getNSamples()}; 
-            return PyArray_SimpleNewFromData(4, dims, NPY_DOUBLE, (void*)ptr);
+            return signalBankCopy(4, dims, ptr);
+        }
+
+        PyObject* _getSignalView(PyObject* owner, int source, int ear,
+                int channel)
+        {
+            if (! loudness::isPositiveAndLessThanUpper(source, $self -> getNSources()))
+                source = 0;
+            if (! loudness::isPositiveAndLessThanUpper(ear, $self -> getNEars()))
+                ear = 0;
+            if (! loudness::isPositiveAndLessThanUpper(channel, $self -> getNChannels()))
+                channel = 0;
+            const Real* ptr;
+            ptr = $self -> getSignalReadPointer(source, ear, channel, 0);
+            npy_intp dims[1] = {$self -> getNSamples()}; 
+            return signalBankView(owner, 1, dims, ptr);
+        }
+
+        PyObject* _getSignalsView(PyObject* owner)
+        {
+            const Real* ptr;
+            ptr = $self -> getSignalReadPointer(0, 0, 0);
+            npy_intp dims[4] = {$self -> getNSources(),
+                                $self -> getNEars(),
+                                $self -> getNChannels(),
+                                $self -> getNSamples()}; 
+            return signalBankView(owner, 4, dims, ptr);
         }
 
         PyObject* getAggregatedSignals()
@@ -65,19 +135,37 @@ public:
                                 $self -> getNEars(),
                                 $self -> getNChannels(),
                                 $self -> getNSamples()}; 
-            return PyArray_SimpleNewFromData(5, dims, NPY_DOUBLE, (void*)vec.data());
+            return signalBankCopy(5, dims, vec.data());
         }
 
         PyObject* getCentreFreqs()
         {
             const Real* ptr = $self -> getCentreFreqsReadPointer(0);
             npy_intp dims[1] = {$self -> getNChannels()}; 
-            return PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (void*)ptr);
+            return signalBankCopy(1, dims, ptr);
         }
 
+        PyObject* _getCentreFreqsView(PyObject* owner)
+        {
+            const Real* ptr = $self -> getCentreFreqsReadPointer(0);
+            npy_intp dims[1] = {$self -> getNChannels()}; 
+            return signalBankView(owner, 1, dims, ptr);
+        }
+
+        %pythoncode %{
+            def getSignalView(self, source, ear, channel):
+                return self._getSignalView(self, source, ear, channel)
+
+            def getSignalsView(self):
+                return self._getSignalsView(self)
+
+            def getCentreFreqsView(self):
+                return self._getCentreFreqsView(self)
+        %}
+
         void setSignal(int source, int ear, int channel, Real* data, int nSamples)
         {
-            if (! loudness::isPositiveAndLessThanUpper(ear, $self -> getNSources()))
+            if (! loudness::isPositiveAndLessThanUpper(source, $self -> getNSources()))
                 source = 0;
             if (! loudness::isPositiveAndLessThanUpper(ear, $self -> getNEars()))
                 ear = 0;
@@ -85,8 +173,7 @@ public:
                 channel = 0;
             Real* ptr = $self -> getSignalWritePointer(source, ear, channel, 0);
             int nSamplesToCopy = loudness::min(nSamples, $self -> getNSamples());
-            for (int i = 0; i < nSamplesToCopy; ++i)
-                ptr[i] = data[i];
+            std::copy(data, data + nSamplesToCopy, ptr);
         }
 
         void setSignals(Real* data, int nSources, int nEars, int nChannels, int nSamples)
@@ -94,16 +181,14 @@ public:
             Real* ptr = $self -> getSignalWritePointer(0, 0, 0);
             int nSamplesToCopy = loudness::min(nSources*nEars*nChannels*nSamples,
                                                $self -> getNTotalSamples());
-            for (int i = 0; i < nSamplesToCopy; ++i)
-                ptr[i] = data[i];
+            std::copy(data, data + nSamplesToCopy, ptr);
         }
 
         void setCentreFreqs(Real* data, int nChannels)
         {
             Real* ptr = $self -> getCentreFreqsWritePointer(0);
             int nFreqsToCopy = loudness::min(nChannels, $self -> getNChannels());
-            for (int i = 0; i < nFreqsToCopy; i++)
-                ptr[i] = data[i];
+            std::copy(data, data + nFreqsToCopy, ptr);
         }
     }
 };
@@ -28,10 +28,15 @@
 #include "../src/support/AuditoryTools.h"
 #include "../src/support/SignalBank.h"
 #include "../src/support/Module.h"
+#include "../src/support/TableRegistry.h"
 #include "../src/support/Model.h"
 #include "../src/support/FFT.h"
 #include "../src/support/Filter.h"
 #include "../src/support/AudioFileProcessor.h"
+#include "../src/support/BatchProcessor.h"
+#include "../src/support/StationaryBatchProcessor.h"
+#include "../src/support/StationaryLevelSolver.h"
+#include "../src/support/StageCheckpoint.h"
 #include "../src/modules/UnaryOperator.h"
 #include "../src/modules/FIR.h"
 #include "../src/modules/IIR.h"
@@ -62,12 +67,18 @@
 #include "../src/modules/ForwardMaskingPO1998.h"
 #include "../src/modules/InstantaneousLoudnessDIN456311991.h"
 #include "../src/modules/ARAverager.h"
+#include "../src/modules/LoudnessIntegrator.h"
+#include "../src/modules/ARAveragerBank.h"
+#include "../src/modules/ChannelSelector.h"
 #include "../src/modules/PeakFollower.h"
+#include "../src/modules/LoudnessDescriptors.h"
 #include "../src/models/StationaryLoudnessANSIS342007.h"
 #include "../src/models/StationaryLoudnessDIN456311991.h"
 #include "../src/models/StationaryLoudnessCHGM2011.h"
 #include "../src/models/DynamicLoudnessGM2002.h"
 #include "../src/models/DynamicLoudnessCH2012.h"
+#include "../src/support/LoudnessGainSolver.h"
+#include "../src/support/ModelEnsemble.h"
 
 typedef loudness::Real Real;
 typedef loudness::uint unint;
@@ -104,6 +115,10 @@ namespace std {
 %apply (double* IN_ARRAY1, int DIM1) {(Real* data, int nChannels)};
 %apply (double* IN_ARRAY4, int DIM1, int DIM2, int DIM3, int DIM4) {
     (Real* data, int nSources, int nEars, int nChannels, int nSamples)};
+%apply (double* IN_ARRAY3, int DIM1, int DIM2, int DIM3) {
+    (Real* signal, int nSources, int nEars, int nSamples)};
+%apply (double* IN_ARRAY3, int DIM1, int DIM2, int DIM3) {
+    (Real* intensities, int nSpectra, int nEars, int nComponents)};
 
 using namespace std;
 namespace loudness{
@@ -116,13 +131,132 @@ using std::vector;
 %include "../src/thirdParty/spline/Spline.h"
 %include "../src/support/Debug.h"
 %include "../src/support/Common.h"
+%ignore loudness::hashBytes;
 %include "../src/support/UsefulFunctions.h"
 %include "../src/support/AuditoryTools.h"
+//tables are shared internally, only the count is of interest
+%ignore loudness::TableRegistry::share;
+%include "../src/support/TableRegistry.h"
+//clones are owned by the caller
+%newobject loudness::Module::clone;
+%newobject loudness::Model::clone;
+
+/*
+Long running calls release the GIL, so Python threads working on different
+models (e.g. a concurrent.futures.ThreadPoolExecutor over files) run in
+parallel. A model, or an AudioFileProcessor, must still only be used by one
+thread at a time. See Model for the thread safety guarantees.
+*/
+%define RELEASE_GIL(function)
+%exception function {
+    Py_BEGIN_ALLOW_THREADS
+    $action
+    Py_END_ALLOW_THREADS
+}
+%enddef
+
+RELEASE_GIL(loudness::Model::clone);
+RELEASE_GIL(loudness::Model::initialize);
+RELEASE_GIL(loudness::Model::process);
+RELEASE_GIL(loudness::Model::processBlock);
+RELEASE_GIL(loudness::Model::synchronize);
+RELEASE_GIL(loudness::AudioFileProcessor::AudioFileProcessor);
+RELEASE_GIL(loudness::AudioFileProcessor::loadNewAudioFile);
+RELEASE_GIL(loudness::AudioFileProcessor::initialize);
+RELEASE_GIL(loudness::AudioFileProcessor::process);
+RELEASE_GIL(loudness::AudioFileProcessor::processAllFrames);
+RELEASE_GIL(loudness::AudioFileProcessor::processAllFramesInSegments);
+RELEASE_GIL(loudness::BatchProcessor::process);
+RELEASE_GIL(loudness::StationaryBatchProcessor::process);
+RELEASE_GIL(loudness::StationaryLevelSolver::solve);
+RELEASE_GIL(loudness::StageCheckpoint::record);
+RELEASE_GIL(loudness::StageCheckpoint::replay);
+RELEASE_GIL(loudness::StageCheckpoint::process);
+RELEASE_GIL(loudness::LoudnessGainSolver::cache);
+RELEASE_GIL(loudness::LoudnessGainSolver::computeLoudness);
+RELEASE_GIL(loudness::LoudnessGainSolver::solve);
+
+//banks owned by a model or module keep it alive (see SignalBank.i)
+%pythonappend loudness::Module::getOutput %{
+    val._owner = self
+%}
+%pythonappend loudness::Model::getOutput %{
+    val._owner = self
+%}
+%pythonappend loudness::Model::getBlockOutput %{
+    val._owner = self
+%}
+%pythonappend loudness::StationaryBatchProcessor::getOutput %{
+    val._owner = self
+%}
+
+//raw pointers are replaced by processSignalArray() below
+%ignore loudness::Model::processSignal;
+%ignore loudness::Module::setAggregationBuffer;
+
 %include "../src/support/Module.h"
 %include "../src/support/Model.h"
+
+%extend loudness::Model {
+
+    /*
+    Processes a whole signal, a numpy array of shape (nSources, nEars,
+    nSamples), in a single call (see Model::processSignal()). Returns a
+    dictionary mapping each valid name in outputs to a new numpy array of
+    shape (nHops, nSources, nEars, nChannels, nSamples), or None on failure.
+    The arrays are allocated up front and each hop is written straight into
+    them.
+    */
+    PyObject* processSignalArray(Real* signal, int nSources, int nEars,
+            int nSamples, const vector<string>& outputs,
+            int nSamplesToPadStart = 0, int nSamplesToPadEnd = 0)
+    {
+        int nHops = $self -> getNSignalHops(nSamples, nSamplesToPadStart,
+                nSamplesToPadEnd);
+        PyObject* dict = PyDict_New();
+        if (!dict)
+            return NULL;
+        std::map<std::string, Real*> buffers;
+        for (const std::string& name : outputs)
+        {
+            if (!$self -> hasOutput(name) || buffers.count(name))
+                continue;
+            const loudness::SignalBank& output = $self -> getOutput(name);
+            npy_intp dims[5] = {nHops,
+                                output.getNSources(),
+                                output.getNEars(),
+                                output.getNChannels(),
+                                output.getNSamples()};
+            PyObject* array = PyArray_SimpleNew(5, dims, NPY_DOUBLE);
+            if (!array)
+            {
+                Py_DECREF(dict);
+                return NULL;
+            }
+            buffers[name] = (Real*)PyArray_DATA((PyArrayObject*)array);
+            PyDict_SetItemString(dict, name.c_str(), array);
+            Py_DECREF(array);
+        }
+
+        Py_BEGIN_ALLOW_THREADS
+        nHops = $self -> processSignal(signal, nSources, nEars, nSamples,
+                nSamplesToPadStart, nSamplesToPadEnd, buffers);
+        Py_END_ALLOW_THREADS
+        if (nHops == 0)
+        {
+            Py_DECREF(dict);
+            Py_RETURN_NONE;
+        }
+        return dict;
+    }
+}
 %include "../src/support/FFT.h"
 %include "../src/support/Filter.h"
 %include "../src/support/AudioFileProcessor.h"
+%include "../src/support/BatchProcessor.h"
+%include "../src/support/StationaryBatchProcessor.h"
+%include "../src/support/StationaryLevelSolver.h"
+%include "../src/support/StageCheckpoint.h"
 %include "../src/modules/UnaryOperator.h"
 %include "../src/modules/FIR.h"
 %include "../src/modules/IIR.h"
@@ -153,9 +287,15 @@ using std::vector;
 %include "../src/modules/ForwardMaskingPO1998.h"
 %include "../src/modules/InstantaneousLoudnessDIN456311991.h"
 %include "../src/modules/ARAverager.h"
+%include "../src/modules/LoudnessIntegrator.h"
+%include "../src/modules/ARAveragerBank.h"
+%include "../src/modules/ChannelSelector.h"
 %include "../src/modules/PeakFollower.h"
+%include "../src/modules/LoudnessDescriptors.h"
 %include "../src/models/StationaryLoudnessANSIS342007.h"
 %include "../src/models/StationaryLoudnessDIN456311991.h"
 %include "../src/models/StationaryLoudnessCHGM2011.h"
 %include "../src/models/DynamicLoudnessGM2002.h"
 %include "../src/models/DynamicLoudnessCH2012.h"
+%include "../src/support/LoudnessGainSolver.h"
+%include "../src/support/ModelEnsemble.h"
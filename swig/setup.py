@@ -33,9 +33,17 @@ if __name__ == "__main__":
                     "../src/support/SignalBank.cpp",
                     "../src/support/Module.cpp",
                     "../src/support/Model.cpp",
+                    "../src/support/ThreadPool.cpp",
+                    "../src/support/TableRegistry.cpp",
                     "../src/support/FFT.cpp",
                     "../src/support/Filter.cpp",
                     "../src/support/AudioFileProcessor.cpp",
+                    "../src/support/BatchProcessor.cpp",
+                    "../src/support/StationaryBatchProcessor.cpp",
+                    "../src/support/StationaryLevelSolver.cpp",
+                    "../src/support/StageCheckpoint.cpp",
+                    "../src/support/LoudnessGainSolver.cpp",
+                    "../src/support/ModelEnsemble.cpp",
                     "../src/modules/UnaryOperator.cpp",
                     "../src/modules/FIR.cpp",
                     "../src/modules/IIR.cpp",
@@ -66,7 +74,13 @@ if __name__ == "__main__":
                     "../src/modules/ForwardMaskingPO1998.cpp",
                     "../src/modules/InstantaneousLoudnessDIN456311991.cpp",
                     "../src/modules/ARAverager.cpp",
+                    "../src/modules/LoudnessIntegrator.cpp",
+                    "../src/modules/ARAveragerBank.cpp",
+                    "../src/modules/ChannelSelector.cpp",
                     "../src/modules/PeakFollower.cpp",
+                    "../src/modules/LoudnessDescriptors.cpp",
+                    "../src/modules/PipelineStage.cpp",
+                    "../src/modules/FrameGate.cpp",
                     "../src/models/StationaryLoudnessANSIS342007.cpp",
                     "../src/models/StationaryLoudnessCHGM2011.cpp",
                     "../src/models/StationaryLoudnessDIN456311991.cpp",
@@ -75,8 +89,9 @@ if __name__ == "__main__":
                 ],
                 include_dirs=[numpy_include, "/usr/include"],
                 library_dirs=['/usr/lib', '/usr/local/lib'],
-                libraries=['fftw3', 'sndfile'],
+                libraries=['fftw3', 'sndfile', 'z'],
                 swig_opts=['-c++'],
-                extra_compile_args=["-std=c++11", "-fPIC", "-O3"])
+                extra_compile_args=["-std=c++11", "-fPIC", "-O3", "-pthread"],
+                extra_link_args=["-pthread"])
             ]
         )